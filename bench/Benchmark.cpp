@@ -0,0 +1,127 @@
+#include "Benchmark.ih"
+
+namespace {
+
+double now()
+{
+	timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+string formatNumber(double value)
+{
+	ostringstream out;
+	out << setprecision(9) << value;
+	return out.str();
+}
+
+string quote(string const &str)
+{
+	string quoted("\"");
+	for (string::const_iterator iter = str.begin(); iter != str.end(); ++iter)
+	{
+		if (*iter == '"' || *iter == '\\')
+			quoted += '\\';
+		else if (static_cast<unsigned char>(*iter) < 0x20)
+		{
+			ostringstream escape;
+			escape << "\\u" << hex << setw(4) << setfill('0') <<
+				static_cast<int>(*iter);
+			quoted += escape.str();
+			continue;
+		}
+
+		quoted += *iter;
+	}
+	quoted += '"';
+
+	return quoted;
+}
+
+double median(vector<double> values)
+{
+	sort(values.begin(), values.end());
+
+	size_t middle = values.size() / 2;
+	if (values.size() % 2 == 1)
+		return values[middle];
+
+	return (values[middle - 1] + values[middle]) / 2.0;
+}
+
+}
+
+void BenchmarkRunner::addContext(string const &key, double value)
+{
+	d_context.push_back(make_pair(key, formatNumber(value)));
+}
+
+void BenchmarkRunner::addContext(string const &key, string const &value)
+{
+	d_context.push_back(make_pair(key, quote(value)));
+}
+
+void BenchmarkRunner::run(Benchmark *benchmark)
+{
+	BenchmarkResult result;
+	result.name = benchmark->name();
+	result.unit = benchmark->unit();
+
+	if (d_verbose)
+		cerr << result.name << " ";
+
+	for (size_t i = 0; i < d_repetitions; ++i)
+	{
+		benchmark->setUp();
+
+		double start = now();
+		result.operations = benchmark->run();
+		result.seconds.push_back(now() - start);
+
+		if (d_verbose)
+			cerr << ".";
+	}
+
+	if (d_verbose)
+		cerr << " " << median(result.seconds) << "s" << endl;
+
+	d_results.push_back(result);
+}
+
+void BenchmarkRunner::writeJson(ostream &out) const
+{
+	out << "{\n  \"context\": {";
+	for (size_t i = 0; i < d_context.size(); ++i)
+		out << (i == 0 ? "\n" : ",\n") << "    " << quote(d_context[i].first) <<
+			": " << d_context[i].second;
+	out << "\n  },\n  \"benchmarks\": [";
+
+	for (size_t i = 0; i < d_results.size(); ++i)
+	{
+		BenchmarkResult const &result = d_results[i];
+
+		double medianSeconds = median(result.seconds);
+		double nsPerOperation = result.operations == 0 ? 0.0 :
+			medianSeconds * 1e9 / result.operations;
+
+		out << (i == 0 ? "\n" : ",\n") << "    {\n" <<
+			"      \"name\": " << quote(result.name) << ",\n" <<
+			"      \"unit\": " << quote(result.unit) << ",\n" <<
+			"      \"operations\": " << result.operations << ",\n" <<
+			"      \"repetitions\": " << result.seconds.size() << ",\n" <<
+			"      \"seconds\": [";
+		for (size_t j = 0; j < result.seconds.size(); ++j)
+			out << (j == 0 ? "" : ", ") << formatNumber(result.seconds[j]);
+		out << "],\n" <<
+			"      \"min\": " << formatNumber(*min_element(result.seconds.begin(),
+				result.seconds.end())) << ",\n" <<
+			"      \"median\": " << formatNumber(medianSeconds) << ",\n" <<
+			"      \"mean\": " << formatNumber(accumulate(result.seconds.begin(),
+				result.seconds.end(), 0.0) / result.seconds.size()) << ",\n" <<
+			"      \"nsPerOperation\": " << formatNumber(nsPerOperation) << "\n" <<
+			"    }";
+	}
+
+	out << "\n  ]\n}\n";
+}
@@ -0,0 +1,116 @@
+#ifndef BENCHMARK_HH_
+#define BENCHMARK_HH_
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * A piece of work that is timed in a number of repetitions.
+ */
+class Benchmark
+{
+public:
+	virtual ~Benchmark() {}
+
+	/**
+	 * Return the name of the benchmark, e.g. 'suffixarray.find'.
+	 */
+	virtual std::string name() const = 0;
+
+	/**
+	 * Run one repetition, and return the number of operations that
+	 * were performed.
+	 */
+	virtual size_t run() = 0;
+
+	/**
+	 * Prepare a repetition. The preparation is not timed.
+	 */
+	virtual void setUp() {}
+
+	/**
+	 * Return the unit of the operations, e.g. 'lookups'.
+	 */
+	virtual std::string unit() const = 0;
+};
+
+/**
+ * The timings of a benchmark.
+ */
+struct BenchmarkResult
+{
+	BenchmarkResult() : operations(0) {}
+
+	std::string name;
+	std::string unit;
+
+	// The number of operations per repetition.
+	size_t operations;
+
+	// The wall-clock time of every repetition, in seconds.
+	std::vector<double> seconds;
+};
+
+/**
+ * Runs benchmarks, and writes their results as a JSON object:
+ *
+ * { "context": { ... },
+ *   "benchmarks": [ { "name": ..., "unit": ..., "operations": ...,
+ *     "repetitions": ..., "seconds": [ ... ], "min": ..., "median": ...,
+ *     "mean": ..., "nsPerOperation": ... }, ... ] }
+ *
+ * The context describes the corpus and the build, so that results of
+ * different runs can be compared. The time per operation is computed
+ * from the median repetition.
+ */
+class BenchmarkRunner
+{
+public:
+	BenchmarkRunner(size_t repetitions, bool verbose) :
+		d_repetitions(repetitions), d_verbose(verbose) {}
+
+	/**
+	 * Add a numeric value to the context.
+	 */
+	void addContext(std::string const &key, double value);
+
+	/**
+	 * Add a string value to the context.
+	 */
+	void addContext(std::string const &key, std::string const &value);
+
+	/**
+	 * Return the results of the benchmarks that were run.
+	 */
+	std::vector<BenchmarkResult> const &results() const;
+
+	/**
+	 * Time a benchmark.
+	 */
+	void run(Benchmark *benchmark);
+
+	/**
+	 * Write the context and the results.
+	 */
+	void writeJson(std::ostream &out) const;
+private:
+	BenchmarkRunner(BenchmarkRunner const &other);
+	BenchmarkRunner &operator=(BenchmarkRunner const &other);
+
+	size_t d_repetitions;
+	bool d_verbose;
+
+	// Keys with their formatted JSON values.
+	std::vector<std::pair<std::string, std::string> > d_context;
+
+	std::vector<BenchmarkResult> d_results;
+};
+
+inline std::vector<BenchmarkResult> const &BenchmarkRunner::results() const
+{
+	return d_results;
+}
+
+#endif // BENCHMARK_HH_
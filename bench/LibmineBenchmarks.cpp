@@ -0,0 +1,310 @@
+#include "LibmineBenchmarks.ih"
+
+namespace {
+
+// The settings of mine that the expansion and mining benchmarks use.
+size_t const N = 1;
+double const EXPANSION_FACTOR_ALPHA = 1.0;
+double const SUSP_THRESHOLD = 0.001;
+double const THRESHOLD = 0.001;
+size_t const MIN_FREQ = 2;
+
+// The number of sampled n-grams and words, and the seed of the sample.
+size_t const N_SAMPLES = 100000;
+unsigned long const SAMPLE_SEED = 42;
+
+void readSentences(string const &parsableFilename,
+	string const &unparsableFilename, SentenceHandler *handler)
+{
+	ifstream badIn(unparsableFilename.c_str());
+	if (!badIn.good())
+		throw runtime_error("Could not read '" + unparsableFilename + "'!");
+
+	ifstream goodIn(parsableFilename.c_str());
+	if (!goodIn.good())
+		throw runtime_error("Could not read '" + parsableFilename + "'!");
+
+	TokenizedSentenceReader reader;
+	reader.addHandler(handler);
+	reader.read(goodIn, badIn);
+}
+
+}
+
+BenchmarkCorpus::BenchmarkCorpus(string const &directory) :
+	parsableFilename(directory + "/parsable"),
+	unparsableFilename(directory + "/unparsable"),
+	parsableFsaFilename(directory + "/parsable.fsa"),
+	unparsableFsaFilename(directory + "/unparsable.fsa"),
+	parsableHashAutomaton(new HashAutomaton(parsableFsaFilename)),
+	unparsableHashAutomaton(new HashAutomaton(unparsableFsaFilename)),
+	hashedCorpus(new HashedCorpus(parsableHashAutomaton,
+		unparsableHashAutomaton))
+{
+	readSentences(parsableFilename, unparsableFilename, hashedCorpus.data());
+
+	goodSuffixArray = SuffixArrayPtr(new SuffixArray<int>(hashedCorpus->good(),
+		SuffixArray<int>::SSORT));
+	badSuffixArray = SuffixArrayPtr(new SuffixArray<int>(hashedCorpus->bad(),
+		SuffixArray<int>::SSORT));
+
+	// Split the unparsable corpus into its sentences.
+	vector<int> const &bad = *hashedCorpus->bad();
+	vector<size_t> const &starts = *hashedCorpus->badSentenceStarts();
+	for (size_t i = 0; i < starts.size(); ++i)
+	{
+		size_t end = i + 1 < starts.size() ? starts[i + 1] : bad.size();
+		unparsableSentences.push_back(Tokens(bad.begin() + starts[i],
+			bad.begin() + end));
+	}
+}
+
+vector<string> benchmarkNames()
+{
+	vector<string> names;
+	names.push_back("suffixarray.construct.ssort");
+	names.push_back("suffixarray.construct.stlsort");
+	names.push_back("suffixarray.find");
+	names.push_back("hashautomaton.hash");
+	names.push_back("hashautomaton.decode");
+	names.push_back("expander.bestratio");
+	names.push_back("miner.cycle");
+	names.push_back("mine.full");
+	return names;
+}
+
+QSharedPointer<Benchmark> createBenchmark(string const &name,
+	BenchmarkCorpus const &corpus)
+{
+	if (name == "suffixarray.construct.ssort")
+		return QSharedPointer<Benchmark>(new SuffixArrayConstruction(corpus,
+			SuffixArray<int>::SSORT));
+	if (name == "suffixarray.construct.stlsort")
+		return QSharedPointer<Benchmark>(new SuffixArrayConstruction(corpus,
+			SuffixArray<int>::STLSORT));
+	if (name == "suffixarray.find")
+		return QSharedPointer<Benchmark>(new SuffixArrayFind(corpus));
+	if (name == "hashautomaton.hash")
+		return QSharedPointer<Benchmark>(new HashAutomatonLookup(corpus,
+			HashAutomatonLookup::HASH));
+	if (name == "hashautomaton.decode")
+		return QSharedPointer<Benchmark>(new HashAutomatonLookup(corpus,
+			HashAutomatonLookup::DECODE));
+	if (name == "expander.bestratio")
+		return QSharedPointer<Benchmark>(new BestRatioExpansion(corpus));
+	if (name == "miner.cycle")
+		return QSharedPointer<Benchmark>(new MinerCycle(corpus));
+	if (name == "mine.full")
+		return QSharedPointer<Benchmark>(new FullMine(corpus));
+
+	return QSharedPointer<Benchmark>();
+}
+
+string SuffixArrayConstruction::name() const
+{
+	return d_sortAlgorithm == SuffixArray<int>::SSORT ?
+		"suffixarray.construct.ssort" : "suffixarray.construct.stlsort";
+}
+
+size_t SuffixArrayConstruction::run()
+{
+	SuffixArray<int> suffixArray(d_corpus, d_sortAlgorithm);
+	return d_corpus->size();
+}
+
+string SuffixArrayConstruction::unit() const
+{
+	return "tokens";
+}
+
+SuffixArrayFind::SuffixArrayFind(BenchmarkCorpus const &corpus) :
+	d_suffixArray(corpus.goodSuffixArray), d_sink(0)
+{
+	vector<int> const &good = *corpus.hashedCorpus->good();
+	if (good.empty())
+		return;
+
+	// Sample n-grams at random positions, so that frequent n-grams are
+	// looked up more often, as in expansion.
+	Random random(SAMPLE_SEED);
+	for (size_t i = 0; i < N_SAMPLES; ++i)
+	{
+		size_t length = 1 + random.below(3);
+		size_t start = random.below(good.size());
+		if (start + length > good.size())
+			start = good.size() - length;
+		d_ngrams.push_back(Tokens(good.begin() + start,
+			good.begin() + start + length));
+	}
+}
+
+string SuffixArrayFind::name() const
+{
+	return "suffixarray.find";
+}
+
+size_t SuffixArrayFind::run()
+{
+	for (vector<Tokens>::const_iterator iter = d_ngrams.begin();
+			iter != d_ngrams.end(); ++iter)
+	{
+		SuffixArray<int>::IterPair matches = d_suffixArray->find(iter->begin(),
+			iter->end());
+		d_sink += matches.second - matches.first;
+	}
+
+	return d_ngrams.size();
+}
+
+string SuffixArrayFind::unit() const
+{
+	return "lookups";
+}
+
+HashAutomatonLookup::HashAutomatonLookup(BenchmarkCorpus const &corpus,
+		Direction direction) :
+	d_hashAutomaton(corpus.parsableHashAutomaton), d_direction(direction),
+	d_sink(0)
+{
+	vector<int> const &good = *corpus.hashedCorpus->good();
+	if (good.empty())
+		return;
+
+	Random random(SAMPLE_SEED);
+	for (size_t i = 0; i < N_SAMPLES; ++i)
+	{
+		int hashCode = good[random.below(good.size())];
+		d_hashCodes.push_back(hashCode);
+		d_words.push_back((*d_hashAutomaton)(hashCode));
+	}
+}
+
+string HashAutomatonLookup::name() const
+{
+	return d_direction == HASH ? "hashautomaton.hash" : "hashautomaton.decode";
+}
+
+size_t HashAutomatonLookup::run()
+{
+	if (d_direction == HASH)
+		for (vector<string>::const_iterator iter = d_words.begin();
+				iter != d_words.end(); ++iter)
+			d_sink += (*d_hashAutomaton)(*iter);
+	else
+		for (vector<int>::const_iterator iter = d_hashCodes.begin();
+				iter != d_hashCodes.end(); ++iter)
+			d_sink += (*d_hashAutomaton)(*iter).size();
+
+	return d_words.size();
+}
+
+string HashAutomatonLookup::unit() const
+{
+	return "lookups";
+}
+
+string BestRatioExpansion::name() const
+{
+	return "expander.bestratio";
+}
+
+size_t BestRatioExpansion::run()
+{
+	for (vector<Tokens>::const_iterator sentenceIter =
+			d_corpus->unparsableSentences.begin();
+			sentenceIter != d_corpus->unparsableSentences.end(); ++sentenceIter)
+		for (TokensIter iter = sentenceIter->begin(); iter != sentenceIter->end();
+				++iter)
+			d_sink += (*d_expander)(iter, sentenceIter->end()).size();
+
+	return d_corpus->unparsableSentences.size();
+}
+
+void BestRatioExpansion::setUp()
+{
+	d_expander = ExpanderPtr(new BestRatioExpander(
+		d_corpus->parsableHashAutomaton, d_corpus->unparsableHashAutomaton,
+		d_corpus->goodSuffixArray, d_corpus->badSuffixArray, N,
+		EXPANSION_FACTOR_ALPHA));
+}
+
+string BestRatioExpansion::unit() const
+{
+	return "sentences";
+}
+
+MinerCycle::MinerCycle(BenchmarkCorpus const &corpus)
+{
+	ExpanderPtr expander(new BestRatioExpander(corpus.parsableHashAutomaton,
+		corpus.unparsableHashAutomaton, corpus.goodSuffixArray,
+		corpus.badSuffixArray, N, EXPANSION_FACTOR_ALPHA));
+	d_expanded = QSharedPointer<Miner>(new Miner(corpus.parsableHashAutomaton,
+		corpus.unparsableHashAutomaton, expander, false));
+	readSentences(corpus.parsableFilename, corpus.unparsableFilename,
+		d_expanded.data());
+
+	// With an infinite threshold, mining stops after the first cycle.
+	d_expanded->mine(numeric_limits<double>::max(), SUSP_THRESHOLD);
+}
+
+string MinerCycle::name() const
+{
+	return "miner.cycle";
+}
+
+size_t MinerCycle::run()
+{
+	d_miner->resume(numeric_limits<double>::max(), SUSP_THRESHOLD);
+	return d_miner->nForms();
+}
+
+void MinerCycle::setUp()
+{
+	d_miner = QSharedPointer<Miner>(new Miner(*d_expanded));
+}
+
+string MinerCycle::unit() const
+{
+	return "forms";
+}
+
+string FullMine::name() const
+{
+	return "mine.full";
+}
+
+size_t FullMine::run()
+{
+	QSharedPointer<HashAutomaton> parsableHashAutomaton(
+		new HashAutomaton(d_corpus->parsableFsaFilename));
+	QSharedPointer<HashAutomaton> unparsableHashAutomaton(
+		new HashAutomaton(d_corpus->unparsableFsaFilename));
+
+	HashedCorpus hashedCorpus(parsableHashAutomaton, unparsableHashAutomaton);
+	readSentences(d_corpus->parsableFilename, d_corpus->unparsableFilename,
+		&hashedCorpus);
+
+	SuffixArrayPtr goodSuffixArray(new SuffixArray<int>(hashedCorpus.good(),
+		SuffixArray<int>::SSORT));
+	SuffixArrayPtr badSuffixArray(new SuffixArray<int>(hashedCorpus.bad(),
+		SuffixArray<int>::SSORT));
+
+	ExpanderPtr expander(new BestRatioExpander(parsableHashAutomaton,
+		unparsableHashAutomaton, goodSuffixArray, badSuffixArray, N,
+		EXPANSION_FACTOR_ALPHA));
+	Miner miner(parsableHashAutomaton, unparsableHashAutomaton, expander,
+		false);
+	readSentences(d_corpus->parsableFilename, d_corpus->unparsableFilename,
+		&miner);
+
+	miner.mine(THRESHOLD, SUSP_THRESHOLD);
+	d_sink += miner.suspiciousForms(MIN_FREQ).size();
+
+	return hashedCorpus.goodSentenceStarts()->size() +
+		hashedCorpus.badSentenceStarts()->size();
+}
+
+string FullMine::unit() const
+{
+	return "sentences";
+}
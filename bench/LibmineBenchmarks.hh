@@ -0,0 +1,163 @@
+#ifndef LIBMINE_BENCHMARKS_HH_
+#define LIBMINE_BENCHMARKS_HH_
+
+#include <string>
+#include <vector>
+
+#include <QSharedPointer>
+
+#include <errormining/Expander.hh>
+#include <errormining/HashAutomaton.hh>
+#include <errormining/HashedCorpus.hh>
+#include <errormining/Miner.hh>
+#include <errormining/SuffixArray.hh>
+
+#include "Benchmark.hh"
+
+/**
+ * The data that the benchmarks share: the perfect hash automata, the
+ * hashed corpus and its suffix arrays. A corpus directory contains the
+ * sentence files 'parsable' and 'unparsable', and their automata
+ * 'parsable.fsa' and 'unparsable.fsa'.
+ */
+struct BenchmarkCorpus
+{
+	BenchmarkCorpus(std::string const &directory);
+
+	std::string parsableFilename;
+	std::string unparsableFilename;
+	std::string parsableFsaFilename;
+	std::string unparsableFsaFilename;
+
+	QSharedPointer<errormining::HashAutomaton> parsableHashAutomaton;
+	QSharedPointer<errormining::HashAutomaton> unparsableHashAutomaton;
+	QSharedPointer<errormining::HashedCorpus> hashedCorpus;
+	errormining::SuffixArrayPtr goodSuffixArray;
+	errormining::SuffixArrayPtr badSuffixArray;
+
+	// The unparsable sentences, in unparsable hash codes.
+	std::vector<errormining::Tokens> unparsableSentences;
+};
+
+/**
+ * Return the names of all benchmarks, in the order in which they are run.
+ */
+std::vector<std::string> benchmarkNames();
+
+/**
+ * Create a benchmark by its name. Returns a null pointer if there is no
+ * benchmark with that name.
+ */
+QSharedPointer<Benchmark> createBenchmark(std::string const &name,
+	BenchmarkCorpus const &corpus);
+
+/**
+ * Construction of a suffix array over the parsable corpus.
+ */
+class SuffixArrayConstruction : public Benchmark
+{
+public:
+	SuffixArrayConstruction(BenchmarkCorpus const &corpus,
+		errormining::SuffixArray<int>::SortAlgorithm sortAlgorithm) :
+		d_corpus(corpus.hashedCorpus->good()),
+		d_sortAlgorithm(sortAlgorithm) {}
+	std::string name() const;
+	size_t run();
+	std::string unit() const;
+private:
+	QSharedPointer<std::vector<int> const> d_corpus;
+	errormining::SuffixArray<int>::SortAlgorithm d_sortAlgorithm;
+};
+
+/**
+ * Lookups of unigrams, bigrams and trigrams of the parsable corpus in
+ * its suffix array.
+ */
+class SuffixArrayFind : public Benchmark
+{
+public:
+	SuffixArrayFind(BenchmarkCorpus const &corpus);
+	std::string name() const;
+	size_t run();
+	std::string unit() const;
+private:
+	errormining::SuffixArrayPtr d_suffixArray;
+	std::vector<errormining::Tokens> d_ngrams;
+	size_t d_sink;
+};
+
+/**
+ * Hashing of words, or decoding of hash codes, with the perfect hash
+ * automaton of the parsable corpus.
+ */
+class HashAutomatonLookup : public Benchmark
+{
+public:
+	enum Direction { HASH, DECODE };
+
+	HashAutomatonLookup(BenchmarkCorpus const &corpus, Direction direction);
+	std::string name() const;
+	size_t run();
+	std::string unit() const;
+private:
+	QSharedPointer<errormining::HashAutomaton> d_hashAutomaton;
+	Direction d_direction;
+	std::vector<int> d_hashCodes;
+	std::vector<std::string> d_words;
+	size_t d_sink;
+};
+
+/**
+ * Expansion of every unparsable sentence by a BestRatioExpander, with
+ * the settings of mine. Every repetition starts with an empty cache.
+ */
+class BestRatioExpansion : public Benchmark
+{
+public:
+	BestRatioExpansion(BenchmarkCorpus const &corpus) :
+		d_corpus(&corpus), d_sink(0) {}
+	std::string name() const;
+	size_t run();
+	void setUp();
+	std::string unit() const;
+private:
+	BenchmarkCorpus const *d_corpus;
+	errormining::ExpanderPtr d_expander;
+	size_t d_sink;
+};
+
+/**
+ * One mining cycle, starting from the suspicions after the first cycle.
+ * Every repetition mines a fresh copy of the expanded miner.
+ */
+class MinerCycle : public Benchmark
+{
+public:
+	MinerCycle(BenchmarkCorpus const &corpus);
+	std::string name() const;
+	size_t run();
+	void setUp();
+	std::string unit() const;
+private:
+	QSharedPointer<errormining::Miner> d_expanded;
+	QSharedPointer<errormining::Miner> d_miner;
+};
+
+/**
+ * The steps of a mine run with the default settings, from loading the
+ * automata to ranking the forms. Only writing the results is left out.
+ */
+class FullMine : public Benchmark
+{
+public:
+	FullMine(BenchmarkCorpus const &corpus) :
+		d_corpus(&corpus), d_sink(0) {}
+	std::string name() const;
+	size_t run();
+	std::string unit() const;
+private:
+	BenchmarkCorpus const *d_corpus;
+	size_t d_sink;
+};
+
+#endif // LIBMINE_BENCHMARKS_HH_
@@ -0,0 +1,70 @@
+#include "ProgramOptions.ih"
+
+ProgramOptions::ProgramOptions(int argc, char *argv[])
+	: d_generate(false), d_repetitions(5), d_seed(1), d_nSentences(100000),
+	d_unparsableFraction(0.1), d_verbose(true), d_vocabularySize(50000),
+	d_zipfExponent(1.0), d_arguments(new vector<string>())
+{
+	d_programName = argv[0];
+
+	// We will do our own error reporting.
+	opterr = 0;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "b:gn:qr:s:u:v:z:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'b':
+			{
+				istringstream names(optarg);
+				string name;
+				while (getline(names, name, ','))
+					if (!name.empty())
+						d_benchmarks.push_back(name);
+			}
+			break;
+		case 'g':
+			d_generate = true;
+			break;
+		case 'n':
+			d_nSentences = parseString<size_t>(optarg);
+			break;
+		case 'q':
+			d_verbose = false;
+			break;
+		case 'r':
+			d_repetitions = parseString<size_t>(optarg);
+			break;
+		case 's':
+			d_zipfExponent = parseString<double>(optarg);
+			break;
+		case 'u':
+			d_unparsableFraction = parseString<double>(optarg);
+			break;
+		case 'v':
+			d_vocabularySize = parseString<size_t>(optarg);
+			break;
+		case 'z':
+			d_seed = parseString<unsigned long>(optarg);
+			break;
+		case ':':
+			throw string("Missing option argument for: -") +
+				static_cast<char>(optopt);
+			break;
+		default:
+			throw string("Unknown option: -") + static_cast<char>(optopt);
+		}
+	}
+
+	if (d_repetitions == 0)
+		throw string("At least one repetition is required (-r)");
+
+	if (d_vocabularySize == 0)
+		throw string("The vocabulary can not be empty (-v)");
+
+	if (d_unparsableFraction <= 0.0 || d_unparsableFraction >= 1.0)
+		throw string("The fraction of unparsable sentences must be between 0 and 1 (-u)");
+
+	copy(argv + optind, argv + argc, back_inserter(*d_arguments));
+}
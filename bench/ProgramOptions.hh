@@ -0,0 +1,111 @@
+#ifndef PROGRAM_OPTIONS_HH_
+#define PROGRAM_OPTIONS_HH_
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QSharedPointer>
+
+class ProgramOptions
+{
+public:
+	ProgramOptions(int argc, char *argv[]);
+	std::vector<std::string> const &arguments() const;
+	std::vector<std::string> const &benchmarks() const;
+	bool generate() const;
+	std::string const &programName() const;
+	size_t repetitions() const;
+	unsigned long seed() const;
+	size_t nSentences() const;
+	double unparsableFraction() const;
+	bool verbose() const;
+	size_t vocabularySize() const;
+	double zipfExponent() const;
+private:
+	ProgramOptions(ProgramOptions const &other);
+	ProgramOptions &operator=(ProgramOptions const &other);
+
+	std::string d_programName;
+	std::vector<std::string> d_benchmarks;
+	bool d_generate;
+	size_t d_repetitions;
+	unsigned long d_seed;
+	size_t d_nSentences;
+	double d_unparsableFraction;
+	bool d_verbose;
+	size_t d_vocabularySize;
+	double d_zipfExponent;
+	QSharedPointer<std::vector<std::string> > d_arguments;
+};
+
+template <typename T>
+T parseString(std::string const &str)
+{
+	std::istringstream iss(str);
+	T val;
+	iss >> val;
+
+	if (!iss)
+		throw std::invalid_argument("Error parsing option argument: " + str);
+
+	return val;
+}
+
+inline std::vector<std::string> const &ProgramOptions::arguments() const
+{
+	return *d_arguments;
+}
+
+inline std::vector<std::string> const &ProgramOptions::benchmarks() const
+{
+	return d_benchmarks;
+}
+
+inline bool ProgramOptions::generate() const
+{
+	return d_generate;
+}
+
+inline std::string const &ProgramOptions::programName() const
+{
+	return d_programName;
+}
+
+inline size_t ProgramOptions::repetitions() const
+{
+	return d_repetitions;
+}
+
+inline unsigned long ProgramOptions::seed() const
+{
+	return d_seed;
+}
+
+inline size_t ProgramOptions::nSentences() const
+{
+	return d_nSentences;
+}
+
+inline double ProgramOptions::unparsableFraction() const
+{
+	return d_unparsableFraction;
+}
+
+inline bool ProgramOptions::verbose() const
+{
+	return d_verbose;
+}
+
+inline size_t ProgramOptions::vocabularySize() const
+{
+	return d_vocabularySize;
+}
+
+inline double ProgramOptions::zipfExponent() const
+{
+	return d_zipfExponent;
+}
+
+#endif // PROGRAM_OPTIONS_HH_
@@ -0,0 +1,52 @@
+#ifndef RANDOM_HH_
+#define RANDOM_HH_
+
+#include <cstddef>
+
+#include <QtGlobal>
+
+/**
+ * A small linear congruential generator. Unlike rand(), it gives the
+ * same sequence on every platform, so that generated corpora and
+ * samples are reproducible from their seed.
+ */
+class Random
+{
+public:
+	Random(unsigned long seed) : d_state(seed) { next(); }
+
+	/**
+	 * Return a number in [0, n).
+	 */
+	size_t below(size_t n);
+
+	/**
+	 * Return a number in [0, 1).
+	 */
+	double uniform();
+private:
+	quint64 next();
+
+	quint64 d_state;
+};
+
+inline size_t Random::below(size_t n)
+{
+	return static_cast<size_t>(uniform() * n);
+}
+
+inline double Random::uniform()
+{
+	// The 53 most significant bits fill the mantissa of a double.
+	return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+inline quint64 Random::next()
+{
+	// The multiplier and increment of Knuth's MMIX.
+	d_state = d_state * Q_UINT64_C(6364136223846793005) +
+		Q_UINT64_C(1442695040888963407);
+	return d_state;
+}
+
+#endif // RANDOM_HH_
@@ -0,0 +1,123 @@
+#include "ZipfCorpus.ih"
+
+namespace {
+
+// The number of distinct error tokens.
+size_t const N_ERRORS = 100;
+
+// Sentences have between MIN_LENGTH and MAX_LENGTH tokens.
+size_t const MIN_LENGTH = 5;
+size_t const MAX_LENGTH = 30;
+
+}
+
+ZipfCorpus::ZipfCorpus(size_t vocabularySize, double exponent,
+		unsigned long seed) :
+	d_cumulative(vocabularySize), d_random(seed)
+{
+	double sum = 0.0;
+	for (size_t rank = 1; rank <= vocabularySize; ++rank)
+	{
+		sum += 1.0 / pow(static_cast<double>(rank), exponent);
+		d_cumulative[rank - 1] = sum;
+	}
+
+	for (vector<double>::iterator iter = d_cumulative.begin();
+			iter != d_cumulative.end(); ++iter)
+		*iter /= sum;
+}
+
+vector<string> ZipfCorpus::sentence(bool unparsable)
+{
+	size_t length = MIN_LENGTH + d_random.below(MAX_LENGTH - MIN_LENGTH + 1);
+
+	vector<string> tokens;
+	for (size_t i = 0; i < length; ++i)
+	{
+		ostringstream token;
+		token << "w" << zipfRank();
+		tokens.push_back(token.str());
+	}
+
+	if (unparsable)
+	{
+		ostringstream error;
+		error << "err" << d_random.below(N_ERRORS);
+		tokens[d_random.below(length)] = error.str();
+	}
+
+	return tokens;
+}
+
+void ZipfCorpus::write(string const &directory, size_t nSentences,
+	double unparsableFraction)
+{
+	if (!QDir().mkpath(QString::fromLocal8Bit(directory.c_str())))
+		throw runtime_error("Could not create " + directory);
+
+	string parsableFilename = directory + "/parsable";
+	ofstream parsable(parsableFilename.c_str());
+	if (!parsable.good())
+		throw runtime_error("Could not write " + parsableFilename);
+
+	string unparsableFilename = directory + "/unparsable";
+	ofstream unparsable(unparsableFilename.c_str());
+	if (!unparsable.good())
+		throw runtime_error("Could not write " + unparsableFilename);
+
+	set<string> parsableTypes;
+	set<string> unparsableTypes;
+	for (size_t i = 0; i < nSentences; ++i)
+	{
+		bool isUnparsable = d_random.uniform() < unparsableFraction;
+		vector<string> tokens = sentence(isUnparsable);
+
+		ofstream &out = isUnparsable ? unparsable : parsable;
+		set<string> &types = isUnparsable ? unparsableTypes : parsableTypes;
+		for (size_t j = 0; j < tokens.size(); ++j)
+		{
+			if (j != 0)
+				out << " ";
+			out << tokens[j];
+			types.insert(tokens[j]);
+		}
+		out << "\n";
+	}
+
+	parsable.flush();
+	unparsable.flush();
+	if (!parsable.good() || !unparsable.good())
+		throw runtime_error("Could not write the corpus to " + directory);
+
+	writeTypes(parsableTypes, parsableFilename + ".types");
+	writeTypes(unparsableTypes, unparsableFilename + ".types");
+}
+
+void ZipfCorpus::writeTypes(set<string> const &types, string const &filename)
+{
+	ofstream out(filename.c_str());
+	if (!out.good())
+		throw runtime_error("Could not write " + filename);
+
+	// Strings are ordered bytewise, which is the POSIX collation that
+	// fsa_build expects.
+	for (set<string>::const_iterator iter = types.begin();
+			iter != types.end(); ++iter)
+		out << *iter << "\n";
+
+	out.flush();
+	if (!out.good())
+		throw runtime_error("Could not write " + filename);
+}
+
+size_t ZipfCorpus::zipfRank()
+{
+	vector<double>::const_iterator iter = upper_bound(d_cumulative.begin(),
+		d_cumulative.end(), d_random.uniform());
+
+	// Rounding can leave the last cumulative probability just below one.
+	if (iter == d_cumulative.end())
+		--iter;
+
+	return (iter - d_cumulative.begin()) + 1;
+}
@@ -0,0 +1,60 @@
+#ifndef ZIPF_CORPUS_HH_
+#define ZIPF_CORPUS_HH_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Random.hh"
+
+/**
+ * Generates a synthetic corpus of parsable and unparsable sentences.
+ * Words are drawn from a Zipfian distribution: the probability of the
+ * word with rank r is proportional to 1 / r^s. Every unparsable sentence
+ * contains one of a small set of error tokens, that do not occur in
+ * parsable sentences, so that the miner has forms to find. The corpus
+ * is determined by the parameters and the seed.
+ */
+class ZipfCorpus
+{
+public:
+	/**
+	 * Construct a generator.
+	 *
+	 * @param vocabularySize The number of distinct words.
+	 * @param exponent The exponent s of the distribution.
+	 * @param seed The seed of the random number generator.
+	 */
+	ZipfCorpus(size_t vocabularySize, double exponent, unsigned long seed);
+
+	/**
+	 * Write a corpus to the files 'parsable' and 'unparsable' in a
+	 * directory, which is created if necessary. The types of each file
+	 * are written in POSIX order to 'parsable.types' and
+	 * 'unparsable.types', as the input for fsa_build.
+	 *
+	 * @param directory The directory of the corpus.
+	 * @param nSentences The total number of sentences.
+	 * @param unparsableFraction The fraction of unparsable sentences.
+	 */
+	void write(std::string const &directory, size_t nSentences,
+		double unparsableFraction);
+private:
+	ZipfCorpus(ZipfCorpus const &other);
+	ZipfCorpus &operator=(ZipfCorpus const &other);
+
+	// Generate a sentence.
+	std::vector<std::string> sentence(bool unparsable);
+
+	// Write the types of a corpus.
+	static void writeTypes(std::set<std::string> const &types,
+		std::string const &filename);
+
+	// Draw the rank of a word, counting from 1.
+	size_t zipfRank();
+
+	std::vector<double> d_cumulative;
+	Random d_random;
+};
+
+#endif // ZIPF_CORPUS_HH_
@@ -0,0 +1,18 @@
+include('../errormining.pri')
+
+TEMPLATE = app
+TARGET = ../bin/minebench
+CONFIG += qt debug_and_release warn_on
+QT = core
+
+SOURCES += minebench.cpp Benchmark.cpp LibmineBenchmarks.cpp ProgramOptions.cpp \
+	ZipfCorpus.cpp
+HEADERS += Benchmark.hh LibmineBenchmarks.hh ProgramOptions.hh Random.hh \
+	ZipfCorpus.hh
+
+# Internal headers
+HEADERS += Benchmark.ih LibmineBenchmarks.ih ProgramOptions.ih ZipfCorpus.ih
+
+mac {
+        CONFIG -= app_bundle
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QSharedPointer>
+#include <QThread>
+
+#include <errormining/Form.hh>
+
+#include "Benchmark.hh"
+#include "LibmineBenchmarks.hh"
+#include "ProgramOptions.hh"
+#include "ZipfCorpus.hh"
+
+using namespace std;
+using namespace errormining;
+
+void usage(string const &programName)
+{
+	cerr << "Usage: " << programName << " [OPTION]... corpus_dir" << endl << endl <<
+		"Runs the benchmarks on the corpus in corpus_dir, and writes the" << endl <<
+		"timings as JSON to standard output." << endl << endl <<
+		"  -b names\tOnly run the given comma-separated benchmarks" << endl <<
+		"  -g\t\tGenerate a synthetic corpus in corpus_dir, rather than" << endl <<
+		"\t\trunning the benchmarks" << endl <<
+		"  -n n\t\tGenerate n sentences (default: 100000)" << endl <<
+		"  -q\t\tBe quiet" << endl <<
+		"  -r n\t\tRun every benchmark n times (default: 5)" << endl <<
+		"  -s s\t\tZipf exponent of the word distribution (default: 1.0)" << endl <<
+		"  -u f\t\tFraction of unparsable sentences (default: 0.1)" << endl <<
+		"  -v n\t\tVocabulary size (default: 50000)" << endl <<
+		"  -z seed\tSeed of the corpus generator (default: 1)" << endl << endl <<
+		"Benchmarks:";
+	vector<string> names = benchmarkNames();
+	for (vector<string>::const_iterator iter = names.begin();
+			iter != names.end(); ++iter)
+		cerr << " " << *iter;
+	cerr << endl << endl <<
+		"The corpus directory must contain the perfect hash automata" << endl <<
+		"parsable.fsa and unparsable.fsa, see run-benchmarks.sh." << endl << endl;
+}
+
+void generate(ProgramOptions const &programOptions, string const &directory)
+{
+	if (programOptions.verbose())
+		cerr << "Generating " << programOptions.nSentences() <<
+			" sentences in " << directory << "... ";
+
+	ZipfCorpus corpus(programOptions.vocabularySize(),
+		programOptions.zipfExponent(), programOptions.seed());
+	corpus.write(directory, programOptions.nSentences(),
+		programOptions.unparsableFraction());
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl;
+}
+
+void benchmark(ProgramOptions const &programOptions, string const &directory)
+{
+	vector<string> allNames = benchmarkNames();
+	vector<string> names = programOptions.benchmarks().empty() ?
+		allNames : programOptions.benchmarks();
+
+	// Check the names before the corpus is read.
+	for (vector<string>::const_iterator iter = names.begin();
+			iter != names.end(); ++iter)
+		if (find(allNames.begin(), allNames.end(), *iter) == allNames.end())
+			throw runtime_error("Unknown benchmark: " + *iter);
+
+	if (programOptions.verbose())
+		cerr << "Reading the corpus... ";
+
+	BenchmarkCorpus corpus(directory);
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl;
+
+	BenchmarkRunner runner(programOptions.repetitions(),
+		programOptions.verbose());
+	runner.addContext("corpus", directory);
+	runner.addContext("parsableSentences",
+		corpus.hashedCorpus->goodSentenceStarts()->size());
+	runner.addContext("parsableTokens", corpus.hashedCorpus->good()->size());
+	runner.addContext("unparsableSentences",
+		corpus.hashedCorpus->badSentenceStarts()->size());
+	runner.addContext("unparsableTokens", corpus.hashedCorpus->bad()->size());
+	runner.addContext("suspicionBytes", sizeof(Suspicion));
+	runner.addContext("formBytes", sizeof(Form));
+	runner.addContext("idealThreadCount", QThread::idealThreadCount());
+
+	for (vector<string>::const_iterator iter = names.begin();
+			iter != names.end(); ++iter)
+	{
+		QSharedPointer<Benchmark> benchmark = createBenchmark(*iter, corpus);
+		runner.run(benchmark.data());
+	}
+
+	runner.writeJson(cout);
+}
+
+int main(int argc, char *argv[])
+{
+	QSharedPointer<ProgramOptions> programOptions;
+	try
+	{
+		programOptions = QSharedPointer<ProgramOptions>(new ProgramOptions(argc, argv));
+	}
+	catch (string error)
+	{
+		cerr << error << endl << endl;
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (programOptions->arguments().size() != 1)
+	{
+		usage(programOptions->programName());
+		return 1;
+	}
+
+	try {
+		if (programOptions->generate())
+			generate(*programOptions, programOptions->arguments()[0]);
+		else
+			benchmark(*programOptions, programOptions->arguments()[0]);
+	} catch (runtime_error const &e) {
+		cerr << e.what() << endl;
+		return 1;
+	}
+}
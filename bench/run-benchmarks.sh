@@ -0,0 +1,35 @@
+#!/bin/sh
+#
+# Generate a synthetic corpus, build its perfect hash automata, and run
+# the benchmarks. The results are written as JSON to standard output.
+#
+# Usage: run-benchmarks.sh [corpus_dir [sentences [minebench options]]]
+#
+# The corpus is only generated if corpus_dir does not contain one yet,
+# so that repeated runs measure the same corpus. Set FSA_BUILD if
+# fsa_build is not in the PATH.
+
+set -e
+
+BINDIR=`dirname $0`/../bin
+FSA_BUILD=${FSA_BUILD:-fsa_build}
+
+CORPUS=${1:-bench-corpus}
+SENTENCES=${2:-100000}
+if [ $# -ge 2 ]; then
+	shift 2
+else
+	shift $#
+fi
+
+if [ ! -f $CORPUS/parsable ]; then
+	$BINDIR/minebench -g -n $SENTENCES $CORPUS
+fi
+
+for corpus in parsable unparsable; do
+	if [ ! -f $CORPUS/$corpus.fsa ]; then
+		$FSA_BUILD -N -o $CORPUS/$corpus.fsa < $CORPUS/$corpus.types
+	fi
+done
+
+$BINDIR/minebench "$@" $CORPUS
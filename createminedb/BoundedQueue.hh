@@ -0,0 +1,91 @@
+#ifndef BOUNDED_QUEUE_HH_
+#define BOUNDED_QUEUE_HH_
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQueue>
+#include <QWaitCondition>
+
+/**
+ * A thread-safe FIFO queue with a maximum size. Producers block while
+ * the queue is full, consumers block while it is empty. A queue can be
+ * aborted, which wakes up all waiting threads.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+	BoundedQueue(int capacity) : d_capacity(capacity), d_aborted(false) {}
+
+	/**
+	 * Abort the queue. Subsequent and waiting puts and takes fail.
+	 */
+	void abort();
+
+	/**
+	 * Add an item, blocks while the queue is full. Returns false if the
+	 * queue was aborted.
+	 */
+	bool put(T const &item);
+
+	/**
+	 * Remove the oldest item, blocks while the queue is empty. Returns
+	 * false if the queue was aborted.
+	 */
+	bool take(T *item);
+private:
+	BoundedQueue(BoundedQueue const &other);
+	BoundedQueue &operator=(BoundedQueue const &other);
+
+	int d_capacity;
+	bool d_aborted;
+	QQueue<T> d_queue;
+	QMutex d_mutex;
+	QWaitCondition d_notEmpty;
+	QWaitCondition d_notFull;
+};
+
+template <typename T>
+void BoundedQueue<T>::abort()
+{
+	QMutexLocker locker(&d_mutex);
+	d_aborted = true;
+	d_notEmpty.wakeAll();
+	d_notFull.wakeAll();
+}
+
+template <typename T>
+bool BoundedQueue<T>::put(T const &item)
+{
+	QMutexLocker locker(&d_mutex);
+
+	while (!d_aborted && d_queue.size() >= d_capacity)
+		d_notFull.wait(&d_mutex);
+
+	if (d_aborted)
+		return false;
+
+	d_queue.enqueue(item);
+	d_notEmpty.wakeOne();
+
+	return true;
+}
+
+template <typename T>
+bool BoundedQueue<T>::take(T *item)
+{
+	QMutexLocker locker(&d_mutex);
+
+	while (!d_aborted && d_queue.isEmpty())
+		d_notEmpty.wait(&d_mutex);
+
+	if (d_aborted)
+		return false;
+
+	*item = d_queue.dequeue();
+	d_notFull.wakeOne();
+
+	return true;
+}
+
+#endif // BOUNDED_QUEUE_HH_
@@ -0,0 +1,111 @@
+#include "BulkInserter.ih"
+
+namespace {
+
+// Larger batches do not give a measurable speedup.
+size_t const MAX_ROWS_PER_BATCH = 256;
+
+}
+
+BulkInserter::BulkInserter(SqliteDatabase *db, string const &table,
+		vector<string> const &columns) :
+	d_db(db), d_table(table), d_columns(columns), d_batchStmt(0),
+	d_nValues(0)
+{
+	// The number of host parameters in a statement is limited.
+	size_t maxVariables = sqlite3_limit(d_db->handle(),
+		SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+	d_rowsPerBatch = max<size_t>(1,
+		min(MAX_ROWS_PER_BATCH, maxVariables / d_columns.size()));
+
+	d_batchStmt = d_db->prepare(insertSql(d_rowsPerBatch));
+	d_values.resize(d_rowsPerBatch * d_columns.size());
+}
+
+BulkInserter::~BulkInserter()
+{
+	sqlite3_finalize(d_batchStmt);
+}
+
+void BulkInserter::flush()
+{
+	if (d_nValues == d_values.size())
+		insert(d_batchStmt, d_nValues);
+	else if (d_nValues != 0)
+	{
+		// Partial batch, only happens once per table, normally.
+		sqlite3_stmt *stmt = d_db->prepare(
+			insertSql(d_nValues / d_columns.size()));
+		try {
+			insert(stmt, d_nValues);
+		} catch (...) {
+			sqlite3_finalize(stmt);
+			throw;
+		}
+		sqlite3_finalize(stmt);
+	}
+
+	d_nValues = 0;
+}
+
+void BulkInserter::insert(sqlite3_stmt *stmt, size_t nValues)
+{
+	for (size_t i = 0; i < nValues; ++i)
+	{
+		Value const &value = d_values[i];
+		int rc = SQLITE_OK;
+
+		switch (value.type)
+		{
+		case Value::INTEGER:
+			rc = sqlite3_bind_int64(stmt, i + 1, value.integer);
+			break;
+		case Value::REAL:
+			rc = sqlite3_bind_double(stmt, i + 1, value.real);
+			break;
+		case Value::TEXT:
+			// The value outlives the statement execution.
+			rc = sqlite3_bind_text(stmt, i + 1, value.text.data(),
+				value.text.size(), SQLITE_STATIC);
+			break;
+		case Value::BLOB:
+			rc = sqlite3_bind_blob(stmt, i + 1, value.text.data(),
+				value.text.size(), SQLITE_STATIC);
+			break;
+		case Value::NULL_VALUE:
+			rc = sqlite3_bind_null(stmt, i + 1);
+			break;
+		}
+
+		d_db->check(rc, "Error binding value for " + d_table);
+	}
+
+	d_db->check(sqlite3_step(stmt), "Error inserting into " + d_table);
+	d_db->check(sqlite3_reset(stmt), "Error inserting into " + d_table);
+}
+
+string BulkInserter::insertSql(size_t nRows) const
+{
+	string row("(");
+	for (size_t i = 0; i < d_columns.size(); ++i)
+		row += i == 0 ? "?" : ", ?";
+	row += ")";
+
+	string sql("INSERT INTO " + d_table + " (");
+	for (size_t i = 0; i < d_columns.size(); ++i)
+	{
+		if (i != 0)
+			sql += ", ";
+		sql += d_columns[i];
+	}
+	sql += ") VALUES ";
+
+	for (size_t i = 0; i < nRows; ++i)
+	{
+		if (i != 0)
+			sql += ", ";
+		sql += row;
+	}
+
+	return sql;
+}
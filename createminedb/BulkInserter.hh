@@ -0,0 +1,153 @@
+#ifndef BULK_INSERTER_HH_
+#define BULK_INSERTER_HH_
+
+#include <string>
+#include <vector>
+
+#include <sqlite3.h>
+
+#include "SqliteDatabase.hh"
+
+/**
+ * Inserts rows into a table in batches, using multi-row INSERT
+ * statements:
+ *
+ * INSERT INTO table (c1, c2) VALUES (?, ?), (?, ?), ...
+ *
+ * Values are added column by column, a row is complete once a value
+ * for every column was added. Full batches are inserted as soon as they
+ * are complete, a final partial batch is inserted by flush(). The caller
+ * is responsible for wrapping the inserts in a transaction.
+ */
+class BulkInserter
+{
+public:
+	/**
+	 * Construct an inserter for the given table and columns.
+	 */
+	BulkInserter(SqliteDatabase *db, std::string const &table,
+		std::vector<std::string> const &columns);
+	~BulkInserter();
+
+	/**
+	 * Add an integer value to the current row.
+	 */
+	void add(sqlite3_int64 value);
+
+	/**
+	 * Add a real value to the current row.
+	 */
+	void add(double value);
+
+	/**
+	 * Add a text value to the current row.
+	 */
+	void add(std::string const &value);
+
+	/**
+	 * Add a text value to the current row.
+	 */
+	void add(char const *value, size_t len);
+
+	/**
+	 * Add a BLOB value to the current row.
+	 */
+	void addBlob(char const *value, size_t len);
+
+	/**
+	 * Add a NULL value to the current row.
+	 */
+	void addNull();
+
+	/**
+	 * Insert rows that were not inserted yet.
+	 */
+	void flush();
+private:
+	BulkInserter(BulkInserter const &other);
+	BulkInserter &operator=(BulkInserter const &other);
+
+	struct Value
+	{
+		enum Type { INTEGER, REAL, TEXT, BLOB, NULL_VALUE };
+
+		Type type;
+		sqlite3_int64 integer;
+		double real;
+		// Text or BLOB data.
+		std::string text;
+	};
+
+	Value &nextValue();
+	void insert(sqlite3_stmt *stmt, size_t nValues);
+	std::string insertSql(size_t nRows) const;
+
+	SqliteDatabase *d_db;
+	std::string d_table;
+	std::vector<std::string> d_columns;
+	size_t d_rowsPerBatch;
+	sqlite3_stmt *d_batchStmt;
+	std::vector<Value> d_values;
+	size_t d_nValues;
+};
+
+inline BulkInserter::Value &BulkInserter::nextValue()
+{
+	return d_values[d_nValues++];
+}
+
+inline void BulkInserter::add(sqlite3_int64 value)
+{
+	Value &v = nextValue();
+	v.type = Value::INTEGER;
+	v.integer = value;
+
+	if (d_nValues == d_values.size())
+		flush();
+}
+
+inline void BulkInserter::add(double value)
+{
+	Value &v = nextValue();
+	v.type = Value::REAL;
+	v.real = value;
+
+	if (d_nValues == d_values.size())
+		flush();
+}
+
+inline void BulkInserter::add(char const *value, size_t len)
+{
+	Value &v = nextValue();
+	v.type = Value::TEXT;
+	v.text.assign(value, len);
+
+	if (d_nValues == d_values.size())
+		flush();
+}
+
+inline void BulkInserter::addBlob(char const *value, size_t len)
+{
+	Value &v = nextValue();
+	v.type = Value::BLOB;
+	v.text.assign(value, len);
+
+	if (d_nValues == d_values.size())
+		flush();
+}
+
+inline void BulkInserter::addNull()
+{
+	Value &v = nextValue();
+	v.type = Value::NULL_VALUE;
+
+	if (d_nValues == d_values.size())
+		flush();
+}
+
+inline void BulkInserter::add(std::string const &value)
+{
+	add(value.data(), value.size());
+}
+
+#endif // BULK_INSERTER_HH_
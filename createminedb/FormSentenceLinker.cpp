@@ -0,0 +1,267 @@
+#include "FormSentenceLinker.ih"
+
+namespace {
+
+// Sentences are separated by this token, so that a form can never
+// match across a sentence boundary.
+int const BOUNDARY = 0;
+
+// The number of forms that are linked as one chunk.
+size_t const CHUNK_SIZE = 4096;
+
+// Text ID of parsable sentences.
+uint const PARSABLE = static_cast<uint>(-1);
+
+// 64-bit FNV-1a hash.
+quint64 fingerprint(char const *begin, char const *end)
+{
+	quint64 hash = 14695981039346656037ULL;
+	for (; begin != end; ++begin)
+	{
+		hash ^= static_cast<unsigned char>(*begin);
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+}
+
+FormSentenceLinker::FormSentenceLinker() : d_corpus(new vector<int>)
+{
+	// The boundary token is the empty string, which is never a token.
+	d_vocabulary.insert(QByteArray(), BOUNDARY);
+}
+
+void FormSentenceLinker::index()
+{
+	if (d_corpus->empty())
+		return;
+
+	// Fingerprints are only needed while reading.
+	d_textIdsByFingerprint.clear();
+
+	// Every token in [0..k-1] occurs in the corpus, so we can use the
+	// McIlroy suffix sort.
+	d_suffixArray = QSharedPointer<SuffixArray<int> const>(
+		new SuffixArray<int>(d_corpus, SuffixArray<int>::SSORT));
+}
+
+// Worker thread that links chunks of forms, until all chunks are taken.
+class FormSentenceLinker::LinkWorker : public QThread
+{
+public:
+	LinkWorker(FormSentenceLinker const *linker, MiningResults const *results,
+			vector<int> const *typeIds, QList<FormsRange> const *chunks,
+			QAtomicInt *nextChunk, BoundedQueue<Links> *queue,
+			UniqSentsFreqs *uniqSentsFreqs) :
+		d_linker(linker), d_results(results), d_typeIds(typeIds),
+		d_chunks(chunks), d_nextChunk(nextChunk), d_queue(queue),
+		d_uniqSentsFreqs(uniqSentsFreqs) {}
+protected:
+	void run();
+private:
+	FormSentenceLinker const *d_linker;
+	MiningResults const *d_results;
+	vector<int> const *d_typeIds;
+	QList<FormsRange> const *d_chunks;
+	QAtomicInt *d_nextChunk;
+	BoundedQueue<Links> *d_queue;
+	UniqSentsFreqs *d_uniqSentsFreqs;
+};
+
+void FormSentenceLinker::LinkWorker::run()
+{
+	int chunk;
+	while ((chunk = d_nextChunk->fetchAndAddOrdered(1)) < d_chunks->size())
+	{
+		Links links;
+		d_linker->linkChunk(*d_results, *d_typeIds, (*d_chunks)[chunk],
+			&links, d_uniqSentsFreqs);
+
+		// The queue is aborted when the consumer fails.
+		if (!d_queue->put(links))
+			return;
+	}
+}
+
+void FormSentenceLinker::link(MiningResults const &results,
+	LinkConsumer *consumer, UniqSentsFreqs *uniqSentsFreqs) const
+{
+	// Workers write the frequencies of their own forms, so they can share
+	// the vector.
+	UniqSentsFreqs freqs(results.size(), 0);
+
+	if (!d_suffixArray.isNull())
+	{
+		// Map the vocabulary of the mining results to our vocabulary once,
+		// so that forms can be looked up without any string handling.
+		vector<int> typeIds;
+		typeIds.reserve(results.vocabulary().size());
+		for (vector<string>::const_iterator iter = results.vocabulary().begin();
+				iter != results.vocabulary().end(); ++iter)
+			typeIds.push_back(d_vocabulary.value(
+				QByteArray(iter->data(), iter->size()), -1));
+
+		QList<FormsRange> chunks;
+		for (size_t begin = 0; begin < results.size(); begin += CHUNK_SIZE)
+			chunks.push_back(make_pair(begin,
+				min(begin + CHUNK_SIZE, results.size())));
+
+		int nWorkers = max(QThread::idealThreadCount(), 1);
+		BoundedQueue<Links> queue(nWorkers * 2);
+		QAtomicInt nextChunk(0);
+
+		vector<QSharedPointer<LinkWorker> > workers;
+		for (int i = 0; i < nWorkers; ++i)
+		{
+			workers.push_back(QSharedPointer<LinkWorker>(new LinkWorker(this,
+				&results, &typeIds, &chunks, &nextChunk, &queue, &freqs)));
+			workers.back()->start();
+		}
+
+		try {
+			// Every chunk results in one batch of links.
+			Links links;
+			for (int i = 0; i < chunks.size(); ++i)
+			{
+				queue.take(&links);
+				consumer->consume(links);
+			}
+		} catch (...) {
+			queue.abort();
+			for (size_t i = 0; i < workers.size(); ++i)
+				workers[i]->wait();
+			throw;
+		}
+
+		for (size_t i = 0; i < workers.size(); ++i)
+			workers[i]->wait();
+	}
+
+	if (uniqSentsFreqs != 0)
+		uniqSentsFreqs->swap(freqs);
+}
+
+void FormSentenceLinker::linkChunk(MiningResults const &results,
+	vector<int> const &typeIds, FormsRange const &range, Links *links,
+	UniqSentsFreqs *uniqSentsFreqs) const
+{
+	vector<int> ngram;
+	vector<uint> sentences;
+	vector<uint> textIds;
+	for (size_t form = range.first; form != range.second; ++form)
+	{
+		// Translate the n-gram, forms with a token that does not occur
+		// in any sentence cannot be linked.
+		ngram.clear();
+		quint32 const *formNgram = results.ngram(form);
+		size_t ngramLength = results.ngramLength(form);
+		for (size_t i = 0; i < ngramLength; ++i)
+		{
+			int typeId = typeIds[formNgram[i]];
+			if (typeId == -1)
+				break;
+			ngram.push_back(typeId);
+		}
+
+		if (ngram.size() != ngramLength || ngramLength == 0)
+			continue;
+
+		SuffixArray<int>::IterPair matches =
+			d_suffixArray->find(ngram.begin(), ngram.end());
+
+		sentences.clear();
+		for (vector<size_t>::const_iterator iter = matches.first;
+				iter != matches.second; ++iter)
+			sentences.push_back(sentenceAt(*iter));
+
+		// A form can occur more than once in a sentence.
+		sort(sentences.begin(), sentences.end());
+		sentences.erase(unique(sentences.begin(), sentences.end()),
+			sentences.end());
+
+		textIds.clear();
+		for (vector<uint>::const_iterator iter = sentences.begin();
+				iter != sentences.end(); ++iter)
+		{
+			links->push_back(make_pair(static_cast<uint>(form), *iter));
+
+			uint textId = d_unparsableTextIds[*iter];
+			if (textId != PARSABLE)
+				textIds.push_back(textId);
+		}
+
+		sort(textIds.begin(), textIds.end());
+		(*uniqSentsFreqs)[form] =
+			unique(textIds.begin(), textIds.end()) - textIds.begin();
+	}
+}
+
+size_t FormSentenceLinker::readSentences(string const &filename,
+	bool unparsable)
+{
+	ifstream sentenceStream(filename.c_str());
+	if (!sentenceStream.good())
+		throw runtime_error("Could not open sentence file: " + filename);
+
+	size_t nSentences = 0;
+	string line;
+	while (getline(sentenceStream, line))
+	{
+		d_sentenceStarts.push_back(d_corpus->size());
+
+		// Sentences are compared by their text, without leading and
+		// trailing whitespace.
+		if (unparsable)
+		{
+			size_t textBegin = line.find_first_not_of(" \t\r\n");
+			size_t textEnd = line.find_last_not_of(" \t\r\n") + 1;
+			quint64 textFingerprint = textBegin == string::npos ? 0 :
+				fingerprint(line.data() + textBegin, line.data() + textEnd);
+
+			QHash<quint64, uint>::const_iterator textIter =
+				d_textIdsByFingerprint.find(textFingerprint);
+			if (textIter == d_textIdsByFingerprint.end())
+				textIter = d_textIdsByFingerprint.insert(textFingerprint,
+					d_textIdsByFingerprint.size());
+
+			d_unparsableTextIds.push_back(textIter.value());
+		}
+		else
+			d_unparsableTextIds.push_back(PARSABLE);
+
+		string::const_iterator iter = line.begin();
+		while (iter != line.end())
+		{
+			// Find the next token.
+			while (iter != line.end() && isspace(static_cast<unsigned char>(*iter)))
+				++iter;
+			string::const_iterator tokenBegin = iter;
+			while (iter != line.end() && !isspace(static_cast<unsigned char>(*iter)))
+				++iter;
+
+			if (tokenBegin == iter)
+				break;
+
+			QByteArray token(&*tokenBegin, iter - tokenBegin);
+			QHash<QByteArray, int>::const_iterator typeIter =
+				d_vocabulary.find(token);
+			if (typeIter == d_vocabulary.end())
+				typeIter = d_vocabulary.insert(token, d_vocabulary.size());
+
+			d_corpus->push_back(typeIter.value());
+		}
+
+		d_corpus->push_back(BOUNDARY);
+		++nSentences;
+	}
+
+	return nSentences;
+}
+
+uint FormSentenceLinker::sentenceAt(size_t position) const
+{
+	return upper_bound(d_sentenceStarts.begin(), d_sentenceStarts.end(),
+		position) - d_sentenceStarts.begin() - 1;
+}
@@ -0,0 +1,125 @@
+#ifndef FORM_SENTENCE_LINKER_HH_
+#define FORM_SENTENCE_LINKER_HH_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QByteArray>
+#include <QHash>
+#include <QSharedPointer>
+
+#include <errormining/MiningResults.hh>
+#include <errormining/SuffixArray.hh>
+
+/**
+ * Finds the sentences in which mined forms occur. All sentences are
+ * stored in one token array, with a boundary token after every
+ * sentence, and indexed with a suffix array. The occurrences of a form
+ * are found with a single suffix array lookup, and the positions are
+ * mapped to sentences using the sentence start offsets.
+ *
+ * Sentences are numbered in the order in which they are read, starting
+ * at zero.
+ *
+ * While linking, the number of unique unparsable sentences of every
+ * form is counted as well. Sentences are compared by a fingerprint of
+ * their text, so the sentence texts do not have to be kept in memory.
+ *
+ * Linking is a producer/consumer pipeline: worker threads look up
+ * chunks of forms and put the links in a bounded queue, the thread that
+ * calls link() hands them to a consumer. The links are never all held
+ * in memory.
+ */
+class FormSentenceLinker
+{
+public:
+	/**
+	 * A link between a form and a sentence, as a pair of a form index
+	 * into the mining results, and a sentence number.
+	 */
+	typedef std::pair<uint, uint> Link;
+	typedef std::vector<Link> Links;
+
+	/**
+	 * The number of unique unparsable sentences of every form, indexed by
+	 * form index.
+	 */
+	typedef std::vector<uint> UniqSentsFreqs;
+
+	/**
+	 * Interface for classes that consume links.
+	 */
+	class LinkConsumer
+	{
+	public:
+		virtual ~LinkConsumer() {}
+
+		/**
+		 * Consume a batch of links. This is always called from the
+		 * thread that called link().
+		 */
+		virtual void consume(Links const &links) = 0;
+	};
+
+	FormSentenceLinker();
+
+	/**
+	 * Create the suffix array. This should be called after all
+	 * sentences were read, and before linking.
+	 */
+	void index();
+
+	/**
+	 * Find the sentences in which the forms of the mining results occur.
+	 * Forms are looked up by multiple threads. Links are delivered in
+	 * batches, in no particular order, every link occurs once. If the
+	 * consumer throws an exception, linking is stopped and the exception
+	 * is propagated.
+	 *
+	 * @param uniqSentsFreqs If not null, the number of unique unparsable
+	 *  sentences of every form is stored in this vector.
+	 */
+	void link(errormining::MiningResults const &results,
+		LinkConsumer *consumer, UniqSentsFreqs *uniqSentsFreqs = 0) const;
+
+	/**
+	 * Return the number of sentences that were read.
+	 */
+	size_t nSentences() const;
+
+	/**
+	 * Read sentences from a file, with one tokenized sentence per line.
+	 * Returns the number of sentences that were read.
+	 */
+	size_t readSentences(std::string const &filename, bool unparsable);
+private:
+	FormSentenceLinker(FormSentenceLinker const &other);
+	FormSentenceLinker &operator=(FormSentenceLinker const &other);
+
+	typedef std::pair<size_t, size_t> FormsRange;
+
+	class LinkWorker;
+
+	// Link a range of forms.
+	void linkChunk(errormining::MiningResults const &results,
+		std::vector<int> const &typeIds, FormsRange const &range,
+		Links *links, UniqSentsFreqs *uniqSentsFreqs) const;
+
+	// Return the number of the sentence that contains a corpus position.
+	uint sentenceAt(size_t position) const;
+
+	QHash<QByteArray, int> d_vocabulary;
+	QSharedPointer<std::vector<int> > d_corpus;
+	std::vector<size_t> d_sentenceStarts;
+	QHash<quint64, uint> d_textIdsByFingerprint;
+	std::vector<uint> d_unparsableTextIds;
+	QSharedPointer<errormining::SuffixArray<int> const> d_suffixArray;
+};
+
+inline size_t FormSentenceLinker::nSentences() const
+{
+	return d_sentenceStarts.size();
+}
+
+#endif // FORM_SENTENCE_LINKER_HH_
@@ -0,0 +1,43 @@
+#include "SqliteDatabase.ih"
+
+SqliteDatabase::SqliteDatabase(string const &filename) : d_handle(0)
+{
+	if (sqlite3_open(filename.c_str(), &d_handle) != SQLITE_OK)
+	{
+		string error = d_handle == 0 ? string("out of memory") :
+			string(sqlite3_errmsg(d_handle));
+		sqlite3_close(d_handle);
+		throw runtime_error("Error opening " + filename + ": " + error);
+	}
+}
+
+SqliteDatabase::~SqliteDatabase()
+{
+	sqlite3_close(d_handle);
+}
+
+void SqliteDatabase::check(int resultCode, string const &context)
+{
+	if (resultCode != SQLITE_OK && resultCode != SQLITE_ROW &&
+			resultCode != SQLITE_DONE)
+		throw runtime_error(context + ": " + sqlite3_errmsg(d_handle));
+}
+
+void SqliteDatabase::exec(string const &sql)
+{
+	char *error = 0;
+	if (sqlite3_exec(d_handle, sql.c_str(), 0, 0, &error) != SQLITE_OK)
+	{
+		string msg = error == 0 ? string("unknown error") : string(error);
+		sqlite3_free(error);
+		throw runtime_error("Error executing '" + sql + "': " + msg);
+	}
+}
+
+sqlite3_stmt *SqliteDatabase::prepare(string const &sql)
+{
+	sqlite3_stmt *stmt = 0;
+	check(sqlite3_prepare_v2(d_handle, sql.c_str(), -1, &stmt, 0),
+		"Error preparing '" + sql + "'");
+	return stmt;
+}
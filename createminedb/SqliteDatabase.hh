@@ -0,0 +1,53 @@
+#ifndef SQLITE_DATABASE_HH_
+#define SQLITE_DATABASE_HH_
+
+#include <string>
+
+#include <sqlite3.h>
+
+/**
+ * A thin wrapper around a SQLite database connection. Errors are
+ * reported by throwing std::runtime_error.
+ */
+class SqliteDatabase
+{
+public:
+	/**
+	 * Open or create a database.
+	 */
+	SqliteDatabase(std::string const &filename);
+	~SqliteDatabase();
+
+	/**
+	 * Execute one or more SQL statements that do not return rows.
+	 */
+	void exec(std::string const &sql);
+
+	/**
+	 * Return the underlying connection handle.
+	 */
+	sqlite3 *handle();
+
+	/**
+	 * Compile a statement, the caller should finalize it.
+	 */
+	sqlite3_stmt *prepare(std::string const &sql);
+
+	/**
+	 * Throw an exception with the last error message of the connection
+	 * if the given result code indicates an error.
+	 */
+	void check(int resultCode, std::string const &context);
+private:
+	SqliteDatabase(SqliteDatabase const &other);
+	SqliteDatabase &operator=(SqliteDatabase const &other);
+
+	sqlite3 *d_handle;
+};
+
+inline sqlite3 *SqliteDatabase::handle()
+{
+	return d_handle;
+}
+
+#endif // SQLITE_DATABASE_HH_
@@ -1,280 +1,375 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
-#include <iterator>
+#include <sstream>
 #include <stdexcept>
 #include <string>
-#include <utility>
-#include <list>
+#include <vector>
 
 #include <QCoreApplication>
 #include <QFile>
-#include <QSet>
+#include <QSharedPointer>
 #include <QString>
-#include <QStringList>
-#include <QSqlDatabase>
-#include <QSqlError>
-#include <QSqlQuery>
-#include <QTextStream>
-#include <QVariant>
-#include <QtDebug>
+#include <QThread>
+#include <QTime>
+
+#include <sqlite3.h>
+
+#include <errormining/MiningResults.hh>
+#include <errormining/ScoringMethod.hh>
+#include <errormining/TrigramIndex.hh>
+
+#include "BulkInserter.hh"
+#include "FormSentenceLinker.hh"
+#include "SqliteDatabase.hh"
 
 using namespace std;
+using namespace errormining;
 
-bool openDatabase(QString const &dbFilename)
+void beginBulkLoad(SqliteDatabase *db)
 {
-	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
-	db.setDatabaseName(dbFilename);
-	return db.open();
+	// The database is always created from scratch, so if loading is
+	// interrupted, it can simply be created again. Journaling and
+	// syncing are not useful during the load.
+	db->exec("PRAGMA journal_mode = OFF");
+	db->exec("PRAGMA synchronous = OFF");
+	db->exec("PRAGMA locking_mode = EXCLUSIVE");
+	db->exec("PRAGMA temp_store = MEMORY");
+	db->exec("PRAGMA cache_size = 100000");
+
+	// Allow SQLite to use worker threads for sorting while creating
+	// indexes. Older versions of SQLite ignore this pragma.
+	ostringstream threads;
+	threads << "PRAGMA threads = " << max(QThread::idealThreadCount(), 1);
+	db->exec(threads.str());
 }
 
-void createTables()
+void createTables(SqliteDatabase *db)
 {
-	QSqlQuery cacheSize("PRAGMA default_cache_size = 10000");
-	cacheSize.exec();
+	db->exec("PRAGMA default_cache_size = 10000");
 
-	QSqlDatabase::database().transaction();
-	QSqlQuery createFormsTableQuery("CREATE TABLE forms ("
+	// Every scoring method has a column with precomputed scores.
+	string formsSql("CREATE TABLE forms ("
 		"form TEXT, suspicion REAL, freq INTEGER, suspFreq INTEGER, "
-		"uniqSentsFreq INTEGER)");
-	createFormsTableQuery.exec();
-
-	QSqlQuery createSentencesTableQuery("CREATE TABLE sentences ("
+		"uniqSentsFreq INTEGER");
+	for (size_t i = 0; i < N_SCORING_METHODS; ++i)
+		formsSql += string(", ") + SCORING_METHODS[i].column + " REAL";
+	formsSql += ")";
+
+	db->exec("BEGIN");
+	db->exec(formsSql);
+	db->exec("CREATE TABLE sentences ("
 		"sentence TEXT, unparsable BOOLEAN)");
-	createSentencesTableQuery.exec();
-	
-	QSqlQuery createFormSentenceTableQuery("CREATE TABLE formSentence ("
+	db->exec("CREATE TABLE formSentence ("
 		"formId INTEGER, sentenceId INTEGER)");
-	createFormSentenceTableQuery.exec();
-	
-	QSqlDatabase::database().commit();
+	db->exec("CREATE TABLE sentenceTrigrams ("
+		"trigram INTEGER PRIMARY KEY, sentenceIds BLOB)");
+	// Aggregates over all forms, the viewer keeps them up to date when
+	// forms are removed.
+	db->exec("CREATE TABLE statistics ("
+		"nForms INTEGER, suspicionSum REAL)");
+	db->exec("COMMIT");
 }
 
-size_t addResults(char const *resultsFilename)
+// Indexes are created after all data is loaded. Building an index from
+// scratch is much cheaper than updating it for every inserted row.
+//
+// The indexes on the link table contain both columns, so that the
+// sentences of a form and the forms of a sentence can be found from the
+// index alone. The viewer relies on this to remove forms quickly.
+//
+// The index on a score column follows the ranking order of the viewer
+// and the evaluation tool: descending score, descending unparsable
+// frequency, and ascending form.
+void createIndexes(SqliteDatabase *db)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO forms (form, suspicion, freq, suspFreq) "
-		"VALUES (:form, :suspicion, :freq, :suspFreq)");
+	db->exec("CREATE UNIQUE INDEX form_idx ON forms (form)");
+	db->exec("CREATE INDEX sentenceId_idx ON formSentence (sentenceId, formId)");
+	db->exec("CREATE INDEX formId_idx ON formSentence (formId, sentenceId)");
 
-	QFile resultsFile(resultsFilename);
-	if (!resultsFile.open(QIODevice::ReadOnly | QIODevice::Text))
-		return 0;
-	QTextStream resultsStream(&resultsFile);
-
-	QSqlDatabase::database().transaction();
-
-	size_t longestNgram = 0;
-	while (!resultsStream.atEnd())
+	for (size_t i = 0; i < N_SCORING_METHODS; ++i)
 	{
-		QString line = resultsStream.readLine().trimmed();
-		QStringList lineParts = line.split(" ");
-
-		if (lineParts.size() < 4) 
-			cerr << "Malformed line in result file: " << line.toUtf8().constData() << endl;
-
-		// Extract and bind information.
-		query.bindValue(":suspFreq", lineParts.takeLast());
-		query.bindValue(":freq", lineParts.takeLast());
-		query.bindValue(":suspicion", lineParts.takeLast());
-		query.bindValue(":form", lineParts.join(" "));
-
-		if (static_cast<size_t>(lineParts.size()) > longestNgram)
-			longestNgram = lineParts.size();
-
-		query.exec();
+		string column(SCORING_METHODS[i].column);
+		db->exec("CREATE INDEX " + column + "_idx ON forms (" + column +
+			" DESC, suspFreq DESC, form)");
 	}
+}
 
-	QSqlDatabase::database().commit();
-
-	QSqlQuery createFormsIndexQuery("CREATE UNIQUE INDEX form_idx ON forms (form)");
-	createFormsIndexQuery.exec();
-	
-	return longestNgram;
+// Streams links into the link table, as they are found.
+class LinkTableWriter : public FormSentenceLinker::LinkConsumer
+{
+public:
+	LinkTableWriter(SqliteDatabase *db, size_t nForms, size_t nSentences);
+
+	void consume(FormSentenceLinker::Links const &links);
+
+	/**
+	 * Insert the remaining links.
+	 */
+	void flush();
+
+	/**
+	 * Return a vector that is true for forms that occur in a sentence.
+	 */
+	vector<bool> const &linkedForms() const;
+
+	/**
+	 * Return a vector that is true for sentences that contain a form.
+	 */
+	vector<bool> const &linkedSentences() const;
+private:
+	static vector<string> columns();
+
+	BulkInserter d_inserter;
+	vector<bool> d_linkedForms;
+	vector<bool> d_linkedSentences;
+};
+
+LinkTableWriter::LinkTableWriter(SqliteDatabase *db, size_t nForms,
+		size_t nSentences) :
+	d_inserter(db, "formSentence", columns()),
+	d_linkedForms(nForms, false), d_linkedSentences(nSentences, false)
+{
 }
 
-QHash<QString, uint> getFormIds()
+vector<string> LinkTableWriter::columns()
 {
-	QHash<QString, uint> formIds;
+	vector<string> columns;
+	columns.push_back("formId");
+	columns.push_back("sentenceId");
+	return columns;
+}
 
-	// Prepare a query for finding forms.
-	QSqlQuery formIdQuery;
-	formIdQuery.prepare("SELECT form, rowid FROM forms");
-	formIdQuery.exec();
-	while (formIdQuery.next())
+void LinkTableWriter::consume(FormSentenceLinker::Links const &links)
+{
+	for (FormSentenceLinker::Links::const_iterator iter = links.begin();
+		iter != links.end(); ++iter)
 	{
-		QString form = formIdQuery.value(0).toString();
-		uint formId = formIdQuery.value(1).toUInt();
-		formIds[form] = formId;
-	}
+		// The ID of a form is its index in the results plus one, the ID
+		// of a sentence is its number plus one.
+		d_inserter.add(static_cast<sqlite3_int64>(iter->first + 1));
+		d_inserter.add(static_cast<sqlite3_int64>(iter->second + 1));
 
-	return formIds;
+		d_linkedForms[iter->first] = true;
+		d_linkedSentences[iter->second] = true;
+	}
 }
 
-list<pair<uint, uint> > addSentences(char const *filename, bool unparsable, int n)
+void LinkTableWriter::flush()
 {
-	QFile sentenceFile(filename);
-	if (!sentenceFile.open(QIODevice::ReadOnly | QIODevice::Text))
-		throw runtime_error(string("Could not open sentence file: ") + filename);
-	QTextStream sentenceStream(&sentenceFile);
+	d_inserter.flush();
+}
 
-	// Prepare sentence insertion query.
-	QSqlQuery insertSentenceQuery;
-	insertSentenceQuery.prepare("INSERT INTO sentences (sentence, unparsable) "
-		"VALUES (:sentence, :unparsable)");
-	insertSentenceQuery.bindValue(":unparsable", unparsable);
+vector<bool> const &LinkTableWriter::linkedForms() const
+{
+	return d_linkedForms;
+}
 
-	QHash<QString, uint> formIds = getFormIds();
+vector<bool> const &LinkTableWriter::linkedSentences() const
+{
+	return d_linkedSentences;
+}
 
-	list<pair<uint, uint> > formSentencePairs;
-	QSqlDatabase::database().transaction();
-	while (!sentenceStream.atEnd())
+void addResults(SqliteDatabase *db, MiningResults const &results,
+	vector<bool> const &linkedForms,
+	FormSentenceLinker::UniqSentsFreqs const &uniqSentsFreqs)
+{
+	vector<string> columns;
+	columns.push_back("rowid");
+	columns.push_back("form");
+	columns.push_back("suspicion");
+	columns.push_back("freq");
+	columns.push_back("suspFreq");
+	columns.push_back("uniqSentsFreq");
+
+	vector<QSharedPointer<ScoreFun> > scoreFuns;
+	for (size_t i = 0; i < N_SCORING_METHODS; ++i)
 	{
-		QString sentence = sentenceStream.readLine().trimmed();
-
-		QStringList words = sentence.split(" ");
-
-		list<uint> sentenceForms;
-		for (int i = 0; i < words.size(); ++i)
-			for (int j = 0; j < n; ++j)
-			{
-			if (i + j == words.size())
-				break;
-
-			QStringList formList;
-			copy(words.begin() + i, words.begin() + i + j + 1, back_inserter(formList));
-
-			QString form = formList.join(" ");
-
-			QHash<QString, uint>::const_iterator iter = formIds.find(form);
+		columns.push_back(SCORING_METHODS[i].column);
+		scoreFuns.push_back(selectScoreFun(SCORING_METHODS[i].method));
+	}
 
-			// Sometimes a form that is encountered in a sentence is not known because
-			// a frequency threshold is set in the miner. In this case, skip this form.
-			if (iter == formIds.end())
-				continue;
+	double suspicionSum = 0.0;
 
-			sentenceForms.push_back(iter.value());
+	db->exec("BEGIN");
+	{
+		BulkInserter inserter(db, "forms", columns);
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			// Form IDs are assigned explicitly: the ID of a form is its
+			// index in the results plus one.
+			inserter.add(static_cast<sqlite3_int64>(i + 1));
+			inserter.add(results.form(i));
+			inserter.add(results.suspicion(i));
+			inserter.add(static_cast<sqlite3_int64>(results.freq(i)));
+			inserter.add(static_cast<sqlite3_int64>(results.suspFreq(i)));
+
+			// Forms that do not occur in any sentence have no unique
+			// sentence frequency.
+			if (linkedForms[i])
+				inserter.add(static_cast<sqlite3_int64>(uniqSentsFreqs[i]));
+			else
+				inserter.addNull();
+
+			// Scores are computed as by the viewer, with a unique sentence
+			// frequency of zero for forms without one. Scores that are not
+			// a number are stored as NULL by SQLite.
+			size_t uniqSentsFreq = linkedForms[i] ? uniqSentsFreqs[i] : 0;
+			for (size_t j = 0; j < scoreFuns.size(); ++j)
+				inserter.add((*scoreFuns[j])(results.suspicion(i),
+					results.freq(i), results.suspFreq(i), uniqSentsFreq));
+
+			suspicionSum += results.suspicion(i);
 		}
+		inserter.flush();
 
-		// If none of the forms occurred in the sentence, there's no sense adding it.
-		if (sentenceForms.size() == 0)
-			continue;
+		vector<string> statisticsColumns;
+		statisticsColumns.push_back("nForms");
+		statisticsColumns.push_back("suspicionSum");
 
-		// Insert sentence.
-		insertSentenceQuery.bindValue(":sentence", sentence);
-		insertSentenceQuery.exec();
-
-		// Retrieve the sentence ID.
-		uint sentenceId = insertSentenceQuery.lastInsertId().toUInt();
-
-		for (list<uint>::const_iterator formIter = sentenceForms.begin();
-				formIter != sentenceForms.end(); ++formIter)
-			formSentencePairs.push_back(make_pair(*formIter, sentenceId));
+		BulkInserter statisticsInserter(db, "statistics", statisticsColumns);
+		statisticsInserter.add(static_cast<sqlite3_int64>(results.size()));
+		statisticsInserter.add(suspicionSum);
+		statisticsInserter.flush();
 	}
-	QSqlDatabase::database().commit();
-
-	return formSentencePairs;
+	db->exec("COMMIT");
 }
 
-void populateLinkTable(list<pair<uint, uint> > const &formSentencePairs)
+// If trigramIndex is not null, the stored sentences are added to it.
+void addSentences(SqliteDatabase *db, char const *filename, bool unparsable,
+	vector<bool> const &linkedSentences, size_t *sentence,
+	TrigramIndex *trigramIndex = 0)
 {
-	// Prepare query for insertion into the link table.
-	QSqlQuery insertFormSentenceQuery;
-	insertFormSentenceQuery.prepare("INSERT INTO formSentence (formId, sentenceId) "
-		"VALUES (:formId, :sentenceId)");
-
-	// Insert link table pairs.
-	QSqlDatabase::database().transaction();
-	for (list<pair<uint, uint> >::const_iterator iter = formSentencePairs.begin();
-		iter != formSentencePairs.end(); ++iter)
-	{
-		insertFormSentenceQuery.bindValue(":formId", iter->first);
-		insertFormSentenceQuery.bindValue(":sentenceId", iter->second);
-		insertFormSentenceQuery.exec();
-	}
-	if (insertFormSentenceQuery.lastError().isValid())
-		qDebug() << insertFormSentenceQuery.lastError();
-	QSqlDatabase::database().commit();
-
-	QSqlQuery createSentenceIdIndexQuery("CREATE INDEX sentenceId_idx ON formSentence (sentenceId)");
-	createSentenceIdIndexQuery.exec();
-
-	QSqlQuery createFormIdIndexQuery("CREATE INDEX formId_idx ON formSentence (formId)");
-	createFormIdIndexQuery.exec();
-}
+	ifstream sentenceStream(filename);
+	if (!sentenceStream.good())
+		throw runtime_error(string("Could not open sentence file: ") + filename);
 
-// Extract the set of form IDs, from the form-sentence link table.
-QSet<uint> extractFormIds(
-	list<pair<uint, uint> > const &formSentencePairs)
-{
-	QSet<uint> formIds;
-
-	for (list<pair<uint, uint> >::const_iterator iter =
-			formSentencePairs.begin(); iter != formSentencePairs.end();
-			++iter)
-		formIds.insert(iter->first);
-	
-	return formIds;
-}
+	vector<string> columns;
+	columns.push_back("rowid");
+	columns.push_back("sentence");
+	columns.push_back("unparsable");
 
-void calcUniqSents(QSet<uint> const &sentenceIds)
-{
-	QMap<uint,uint> uniqSentsFreqs;
+	// The Qt SQLite driver stored booleans as text, the viewer and
+	// evaluation tool rely on this.
+	string unparsableValue(unparsable ? "true" : "false");
 
+	db->exec("BEGIN");
 	{
-		// Find the number of unique unparsable sentences for a given form.
-		QSqlQuery uniqueSentenceQuery;
-		uniqueSentenceQuery.prepare("SELECT COUNT(DISTINCT(sentences.sentence)) "
-			"FROM formSentence, sentences WHERE formSentence.formId = :formId "
-			"AND formSentence.sentenceId = sentences.rowid "
-			"AND sentences.unparsable = 'true'");
-
-		for (QSet<uint>::const_iterator iter = sentenceIds.begin();
-				iter != sentenceIds.end(); ++iter)
+		BulkInserter inserter(db, "sentences", columns);
+		string line;
+		for (; getline(sentenceStream, line); ++(*sentence))
 		{
-			uniqueSentenceQuery.bindValue(":formId", *iter);
-			uniqueSentenceQuery.exec();
-			uniqueSentenceQuery.next();
-			uniqSentsFreqs[*iter] = uniqueSentenceQuery.value(0).toUInt();
+			// If none of the forms occurred in the sentence, there's no sense
+			// adding it.
+			if (!linkedSentences[*sentence])
+				continue;
+
+			size_t begin = line.find_first_not_of(" \t\r\n");
+			size_t end = line.find_last_not_of(" \t\r\n");
+
+			inserter.add(static_cast<sqlite3_int64>(*sentence + 1));
+			if (begin == string::npos)
+				inserter.add(string());
+			else
+			{
+				inserter.add(line.data() + begin, end - begin + 1);
+				if (trigramIndex != 0)
+					trigramIndex->add(*sentence + 1, line.data() + begin,
+						end - begin + 1);
+			}
+			inserter.add(unparsableValue);
 		}
+		inserter.flush();
 	}
+	db->exec("COMMIT");
+}
 
-	// Store the unique sentence frequencies given a form.
-	QSqlQuery updateUniqSentsQuery;
-	updateUniqSentsQuery.prepare("UPDATE forms SET uniqSentsFreq = :freq "
-		"WHERE forms.rowid = :formId");
-
-	QSqlDatabase::database().transaction();
-	for (QMap<uint, uint>::const_iterator iter = uniqSentsFreqs.begin();
-		iter != uniqSentsFreqs.end(); ++iter)
+// The viewer uses the trigram index to find candidate sentences for a
+// regular expression, before the expression itself is applied.
+void addTrigramIndex(SqliteDatabase *db, TrigramIndex const &trigramIndex)
+{
+	TrigramIndex::EncodedPostings const &postings =
+		trigramIndex.encodedPostings();
+
+	// Insert in key order, so that the table is built by appending.
+	vector<quint32> trigrams;
+	trigrams.reserve(postings.size());
+	for (TrigramIndex::EncodedPostings::const_iterator iter = postings.begin();
+			iter != postings.end(); ++iter)
+		trigrams.push_back(iter.key());
+	sort(trigrams.begin(), trigrams.end());
+
+	vector<string> columns;
+	columns.push_back("trigram");
+	columns.push_back("sentenceIds");
+
+	db->exec("BEGIN");
 	{
-		updateUniqSentsQuery.bindValue(":formId", iter.key());
-		updateUniqSentsQuery.bindValue(":freq", iter.value());
-		updateUniqSentsQuery.exec();
+		BulkInserter inserter(db, "sentenceTrigrams", columns);
+		for (vector<quint32>::const_iterator iter = trigrams.begin();
+				iter != trigrams.end(); ++iter)
+		{
+			string const &sentenceIds = postings.find(*iter).value();
+			inserter.add(static_cast<sqlite3_int64>(*iter));
+			inserter.addBlob(sentenceIds.data(), sentenceIds.size());
+		}
+		inserter.flush();
 	}
-	QSqlDatabase::database().commit();
+	db->exec("COMMIT");
 }
 
-void populateDatabase(char const *resultsFilename,
+void populateDatabase(SqliteDatabase *db, char const *resultsFilename,
 	char const *unparsableFilename, char const *parsableFilename = 0)
 {
+	QTime timer;
+	timer.start();
+
+	beginBulkLoad(db);
+
 	cerr << "Creating tables... ";
-	createTables();
-	cerr << "done!" << endl << "Adding mining results... ";
-	size_t n = addResults(resultsFilename);
-	cerr << "done!" << endl << "Adding sentences and finding form-sentence links... ";
-	list<pair<uint, uint> > formSentencePairs = addSentences(unparsableFilename, true, n);
+	createTables(db);
+	cerr << "done!" << endl << "Reading mining results... ";
+	// Mining results can be in the text or the binary format.
+	MiningResults results;
+	results.read(resultsFilename);
+	cerr << "done! (" << timer.restart() << " ms)" << endl <<
+		"Indexing sentences... ";
+	FormSentenceLinker linker;
+	linker.readSentences(unparsableFilename, true);
 	if (parsableFilename != 0)
-	{
-		list<pair<uint, uint> > parsableFormSentencePairs = addSentences(parsableFilename, false, n);
-		copy(parsableFormSentencePairs.begin(), parsableFormSentencePairs.end(),
-		     back_inserter(formSentencePairs));
-	}
-	cerr << "done!" << endl << "Populating link table... ";
-	populateLinkTable(formSentencePairs);
-	cerr << "done!" << endl << "Calculating unique sentence frequencies... ";
-	QSet<uint> formIds = extractFormIds(formSentencePairs);
-	calcUniqSents(formIds);
-	cerr << "done!" << endl;
+		linker.readSentences(parsableFilename, false);
+	linker.index();
+	cerr << "done! (" << timer.restart() << " ms)" << endl <<
+		"Populating link table... ";
+	FormSentenceLinker::UniqSentsFreqs uniqSentsFreqs;
+	LinkTableWriter linkTableWriter(db, results.size(), linker.nSentences());
+	db->exec("BEGIN");
+	linker.link(results, &linkTableWriter, &uniqSentsFreqs);
+	linkTableWriter.flush();
+	db->exec("COMMIT");
+	cerr << "done! (" << timer.restart() << " ms)" << endl <<
+		"Adding mining results... ";
+	addResults(db, results, linkTableWriter.linkedForms(), uniqSentsFreqs);
+	cerr << "done! (" << timer.restart() << " ms)" << endl <<
+		"Adding sentences... ";
+	// Sentence IDs are sentence numbers plus one, only sentences that
+	// contain a form are stored.
+	// Only unparsable sentences are indexed, the viewer does not show
+	// parsable sentences.
+	size_t sentence = 0;
+	TrigramIndex trigramIndex;
+	addSentences(db, unparsableFilename, true,
+		linkTableWriter.linkedSentences(), &sentence, &trigramIndex);
+	if (parsableFilename != 0)
+		addSentences(db, parsableFilename, false,
+			linkTableWriter.linkedSentences(), &sentence);
+	cerr << "done! (" << timer.restart() << " ms)" << endl <<
+		"Adding trigram index... ";
+	addTrigramIndex(db, trigramIndex);
+	cerr << "done! (" << timer.restart() << " ms)" << endl <<
+		"Creating indexes... ";
+	createIndexes(db);
+	cerr << "done! (" << timer.restart() << " ms)" << endl;
 }
 
 void usage(string const &programName)
@@ -298,14 +393,15 @@ int main(int argc, char *argv[])
 	if (QFile::exists(dbFilename))
 		QFile::remove(dbFilename);
 		
-	if (!openDatabase(dbFilename)) {
-		cout << "Error opening: " << dbFilename.toLatin1().constData() <<
-			endl;
+	try {
+		SqliteDatabase db(argv[argc - 1]);
+
+		if (argc == 4)
+			populateDatabase(&db, argv[1], argv[2]);
+		else
+			populateDatabase(&db, argv[1], argv[3], argv[2]);
+	} catch (runtime_error const &e) {
+		cerr << e.what() << endl;
 		return 1;
 	}
-
-	if (argc == 4)
-		populateDatabase(argv[1], argv[2]);
-	else
-		populateDatabase(argv[1], argv[3], argv[2]);
 }
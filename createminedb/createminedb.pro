@@ -3,6 +3,14 @@ include('../errormining.pri')
 TEMPLATE = app
 TARGET = ../bin/createminedb
 CONFIG += qt debug_and_release warn_on
-QT = core sql
+QT = core
 
-SOURCES += createminedb.cpp
+SOURCES += BulkInserter.cpp FormSentenceLinker.cpp SqliteDatabase.cpp \
+	createminedb.cpp
+HEADERS += BoundedQueue.hh BulkInserter.hh FormSentenceLinker.hh \
+	SqliteDatabase.hh
+
+# Internal headers
+HEADERS += BulkInserter.ih FormSentenceLinker.ih SqliteDatabase.ih
+
+LIBS += -lsqlite3
@@ -2,6 +2,10 @@ QMAKE_CXXFLAGS += -O2 -Wall -Wextra -I../libmine
 QMAKE_LFLAGS += -O2
 unix:LIBS += -L../lib -lmine
 
+float_suspicion {
+	DEFINES += ERRORMINING_FLOAT_SUSPICION
+}
+
 mac {
 	CONFIG -= app_bundle
 }
@@ -1,90 +1,56 @@
-#include <algorithm>
 #include <cmath>
-#include <functional>
-#include <iterator>
+#include <string>
+#include <vector>
 
 #include <QCoreApplication>
 #include <QFile>
-#include <QHash>
-#include <QSet>
-#include <QSharedPointer>
+#include <QFuture>
+#include <QList>
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
+#include <QThread>
 #include <QVector>
+#include <QtConcurrentMap>
+
+#include <errormining/TaggedCorpusIndex.hh>
+
+using namespace errormining;
 
 /*
  * WARNING: this is just a proof of concept, containing a lot of duplicate
  * code and assumptions. Rewrite for serious use :p.
  */
 
-typedef QSet<int> IndexSet;
-typedef QHash<QString, QSharedPointer<IndexSet> > PositionHash;
-
-inline QSharedPointer<IndexSet> defaultSet()
-{
-  return QSharedPointer<IndexSet>(new IndexSet);
-}
-
-struct Positions {
-  PositionHash wordPositions;
-  PositionHash tagPositions;
-};
-
+/*
+ * A word or tag of a sentence, with its identifiers in the indexes of
+ * the parsable and unparsable corpora.
+ */
 struct Unigram {
   Unigram () {}
-  Unigram(QString const &newType, QString const &newUnigram) :
-      type(newType), unigram(newUnigram) {}
-  QString type;
+  Unigram(QString const &newUnigram, TaggedItem const &newGoodItem,
+      TaggedItem const &newBadItem) :
+      unigram(newUnigram), goodItem(newGoodItem), badItem(newBadItem) {}
   QString unigram;
+  TaggedItem goodItem;
+  TaggedItem badItem;
 };
 
-inline bool operator==(Unigram const &u1, Unigram const &u2)
-{
-  return u1.type == u2.type && u1.unigram == u2.unigram;
+double expansionFactor(int badFreq) {
+  return 1.0 + exp(-0.5 * static_cast<double>(badFreq));
 }
 
-inline uint qHash(Unigram const &unigram)
-{
-  uint h1 = qHash(unigram.type);
-  uint h2 = qHash(unigram.unigram);
-  return ((h1 << 16) | (h1 >> 16)) ^ h2;
+void splitWordTag(QString const &wordTag, QString *word, QString *tag) {
+  int sepIndex = wordTag.lastIndexOf("/");
+  *word = wordTag.left(sepIndex);
+  *tag = wordTag.mid(sepIndex + 1);
 }
 
-template <typename T>
-QSharedPointer<QSet<T> > intersect_set(QSharedPointer<QSet<T> > a,
-    QSharedPointer<QSet<T> > b) {
-  QSharedPointer<QSet<T> > small;
-  QSharedPointer<QSet<T> > big;
-
-  if (a->size() > b->size()) {
-    big = a;
-    small = b;
-  } else {
-    big = b;
-    small = a;
-  }
-
-  QSharedPointer<QSet<T> > inter(new QSet<T>);
-  for (typename QSet<T>::const_iterator iter = small->begin();
-      iter != small->end();
-      ++iter)
-    if (big->contains(*iter))
-      inter->insert(*iter);
-
-  return inter;
+inline std::string toStdString(QString const &str) {
+  return std::string(str.toUtf8().constData());
 }
 
-typedef QPair<Unigram, Unigram> Bigram;
-
-typedef QHash<Bigram, QSharedPointer<IndexSet> > BigramCache;
-
-double expansionFactor(int badFreq) {
-  return 1.0 + exp(-0.5 * static_cast<double>(badFreq));
-}
-
-bool readCorpus(QTextStream &corpusStream, Positions *positions) {
-  int position = 0;
+bool readCorpus(QTextStream &corpusStream, TaggedCorpusIndex *index) {
   QString line;
 
   while (true) {
@@ -96,294 +62,252 @@ bool readCorpus(QTextStream &corpusStream, Positions *positions) {
 
     QStringList lineParts = line.split(" ", QString::SkipEmptyParts);
 
+    std::vector<std::string> words;
+    std::vector<std::string> tags;
     for (QStringList::const_iterator iter = lineParts.begin();
         iter != lineParts.end(); ++iter) {
-      QString wordTag = *iter;
-
-      int sepIndex = wordTag.lastIndexOf("/");
-      QString word(wordTag.left(sepIndex));
-      QString tag(wordTag.mid(sepIndex + 1));
+      QString word;
+      QString tag;
+      splitWordTag(*iter, &word, &tag);
 
-      if (!positions->wordPositions.contains(word))
-        positions->wordPositions[word] = defaultSet(); 
-      positions->wordPositions[word]->insert(position);
-      if (!positions->tagPositions.contains(tag))
-        positions->tagPositions[tag] = defaultSet(); 
-      positions->tagPositions[tag]->insert(position);
-
-      ++position;
+      words.push_back(toStdString(word));
+      tags.push_back(toStdString(tag));
     }
+
+    index->addSentence(words, tags);
   }
 
+  index->index();
+
   return true;
 }
 
-
-double sequenceRatio(BigramCache *goodCache, BigramCache *badCache,
-    Positions const &goodPositions, Positions const &badPositions,
-    QVector<Unigram> seq)
+size_t sequenceFreq(TaggedCorpusIndex const &index, QVector<Unigram> const &seq,
+    bool good)
 {
-  bool fromCache = false;
-
-  QSharedPointer<IndexSet> goodIdx(new IndexSet);
-  QSharedPointer<IndexSet> badIdx(new IndexSet);
-
-  if (seq.size() > 1) {
-      BigramCache::iterator badIter;
-      BigramCache::iterator goodIter;
-      Bigram bigram(seq[0], seq[1]);
-      if ((badIter = badCache->find(bigram)) !=
-          badCache->end() &&
-          (goodIter = goodCache->find(bigram)) !=
-           goodCache->end()) {
-        badIdx = *badIter;
-        goodIdx = *goodIter;
-        seq = seq.mid(2);
-        fromCache = true;
-      }
-  }
-
-  for (int i = 0; i < seq.size(); ++i) {
-   
-    PositionHash const *goodHash = 0;
-    PositionHash const *badHash = 0;
-
-    if (seq[i].type == "w") {
-      goodHash = &goodPositions.wordPositions;
-      badHash = &badPositions.wordPositions;
-    } else {
-      goodHash = &goodPositions.tagPositions;
-      badHash = &badPositions.tagPositions;
-    }
+  MixedNgram ngram;
+  for (QVector<Unigram>::const_iterator iter = seq.begin();
+      iter != seq.end(); ++iter)
+    ngram.push_back(good ? iter->goodItem : iter->badItem);
 
-    if (i == 0 && !fromCache) {
-      goodIdx = goodHash->value(seq[i].unigram, defaultSet());
-      badIdx = badHash->value(seq[i].unigram, defaultSet());
-    } else {
-      QSharedPointer<IndexSet> newGoodIdx(new IndexSet);
-      for (IndexSet::const_iterator iter = goodIdx->begin();
-            iter != goodIdx->end(); ++iter)
-        newGoodIdx->insert(*iter + 1);
-
-      QSharedPointer<IndexSet> newBadIdx(new IndexSet);
-      for (IndexSet::const_iterator iter = badIdx->begin();
-            iter != badIdx->end(); ++iter)
-        newBadIdx->insert(*iter + 1);
-
-      goodIdx = intersect_set(newGoodIdx, goodHash->value(seq[i].unigram,
-        defaultSet()));
-
-      badIdx = intersect_set(newBadIdx, badHash->value(seq[i].unigram,
-        defaultSet()));
-
-      if (i == 1 && !fromCache && (goodIdx->size() > 5 || badIdx->size() > 5)) {
-        Bigram bigram(seq[0], seq[1]);
-        (*goodCache)[bigram] = goodIdx;
-        (*badCache)[bigram] = badIdx;
-      }
-    }
-  }
+  return index.freq(ngram);
+}
 
-  if (badIdx->size() == 0)
+double sequenceRatio(TaggedCorpusIndex const &goodIndex,
+    TaggedCorpusIndex const &badIndex, QVector<Unigram> const &seq)
+{
+  size_t badFreq = sequenceFreq(badIndex, seq, false);
+  if (badFreq == 0)
     return 0.0;
 
-  return static_cast<double>(badIdx->size())
-    / static_cast<double>(goodIdx->size() + badIdx->size());
+  size_t goodFreq = sequenceFreq(goodIndex, seq, true);
+
+  return static_cast<double>(badFreq)
+    / static_cast<double>(goodFreq + badFreq);
 }
 
-void expandCorpus(QTextStream *corpusStream, Positions const &goodPositions,
-    Positions const &badPositions, QTextStream *sentStream,
+/*
+ * Sentences are expanded in chunks, one chunk per task. A progress dot
+ * is printed for every full chunk.
+ */
+int const CHUNK_SIZE = 100;
+
+/*
+ * The expanded sentences and the forms of a chunk.
+ */
+struct ExpandedChunk {
+  QString sentences;
+  QString forms;
+};
+
+void expandSentence(QString const &line, TaggedCorpusIndex const &goodIndex,
+    TaggedCorpusIndex const &badIndex, QTextStream *sentStream,
     QTextStream *formStream)
 {
-  BigramCache goodBigramCache;
-  BigramCache badBigramCache;
+  QStringList lineParts = line.split(" ", QString::SkipEmptyParts);
+
+  QVector<Unigram> tags;
+  QVector<Unigram> words;
+  for (QStringList::const_iterator iter = lineParts.begin();
+      iter != lineParts.end(); ++iter) {
+    QString word;
+    QString tag;
+    splitWordTag(*iter, &word, &tag);
+
+    std::string wordStr(toStdString(word));
+    std::string tagStr(toStdString(tag));
+
+    words.push_back(Unigram(word,
+      TaggedItem(TaggedItem::WORD, goodIndex.wordId(wordStr)),
+      TaggedItem(TaggedItem::WORD, badIndex.wordId(wordStr))));
+    tags.push_back(Unigram(tag,
+      TaggedItem(TaggedItem::TAG, goodIndex.tagId(tagStr)),
+      TaggedItem(TaggedItem::TAG, badIndex.tagId(tagStr))));
+  }
 
-  int count = 0;
+  for (int i = 0; i < words.size(); ++i) {
+    QVector<Unigram> ngram;
+    ngram.push_back(words[i]);
 
-  QString line;
-  while (true) {
-    line = corpusStream->readLine();
-    if (line.isNull())
-      break;
-   
-    QStringList lineParts = line.split(" ", QString::SkipEmptyParts);
+    // First word suspicion
+    size_t goodFreq = sequenceFreq(goodIndex, ngram, true);
+    size_t badFreq = sequenceFreq(badIndex, ngram, false);
+    double susp = static_cast<double>(badFreq) /
+      static_cast<double>(badFreq + goodFreq);
 
-    QVector<Unigram> tags;
-    QVector<Unigram> words;
-    for (QStringList::const_iterator iter = lineParts.begin();
-        iter != lineParts.end(); ++iter) {
-      QString wordTag = *iter;
+    for (int j = i + 1; j < lineParts.size(); ++j) {
+      QVector<Unigram> tagNgram(ngram);
+      tagNgram.push_back(tags[j]);
 
-      int sepIndex = wordTag.lastIndexOf("/");
-      QString word(wordTag.left(sepIndex));
-      QString tag(wordTag.mid(sepIndex + 1));
+      size_t tagGoodFreq = sequenceFreq(goodIndex, tagNgram, true);
+      size_t tagBadFreq = sequenceFreq(badIndex, tagNgram, false);
 
-      words.push_back(Unigram("w", word));
-      tags.push_back(Unigram("t", tag));
-    }
+      double newTagSusp = 0.0;
+      if (tagBadFreq > 0)
+        newTagSusp = static_cast<double>(tagBadFreq) /
+          static_cast<double>(tagBadFreq + tagGoodFreq);
 
-    for (int i = 0; i < words.size(); ++i) {
-      // First word suspicion
-      QSharedPointer<IndexSet> goodIdx =
-        goodPositions.wordPositions.value(words[i].unigram, defaultSet());
-      QSharedPointer<IndexSet> badIdx =
-        badPositions.wordPositions.value(words[i].unigram, defaultSet());
-      double susp = static_cast<double>(badIdx->size()) /
-        static_cast<double>(badIdx->size() + goodIdx->size());
-
-      QVector<Unigram> ngram;
-      ngram.push_back(words[i]);
-
-      for (int j = i + 1; j < lineParts.size(); ++j) {
-        QSharedPointer<IndexSet> tagGoodIdx;
-        QSharedPointer<IndexSet> tagBadIdx;
-
-        bool fromCache = false;
-        if (ngram.size() == 1) {
-            BigramCache::const_iterator goodIter;
-            BigramCache::const_iterator badIter;
-            Bigram bigram(ngram[0], tags[j]);
-            if ((goodIter = goodBigramCache.find(bigram)) !=
-                  goodBigramCache.end() &&
-                (badIter = badBigramCache.find(bigram)) !=
-                  badBigramCache.end()) {
-              tagGoodIdx = *goodIter;
-              tagBadIdx = *badIter;
-              fromCache = true;
-            }
-        }
+      double ef = expansionFactor(tagBadFreq);
 
-        if (!fromCache) {
-          QSharedPointer<IndexSet> newGoodIdx(new IndexSet);
-          for (IndexSet::const_iterator iter = goodIdx->begin();
-              iter != goodIdx->end(); ++iter)
-            newGoodIdx->insert(*iter + 1);
+      QVector<Unigram> secondGram = ngram.mid(1);
+      secondGram.push_back(tags[j]);
+      double susp2 = sequenceRatio(goodIndex, badIndex, secondGram);
 
-          QSharedPointer<IndexSet> newBadIdx(new IndexSet);
-          for (IndexSet::const_iterator iter = badIdx->begin();
-              iter != badIdx->end(); ++iter)
-            newBadIdx->insert(*iter + 1);
+      if (newTagSusp > susp * ef && newTagSusp > susp2 * ef) {
+        ngram = tagNgram;
+        goodFreq = tagGoodFreq;
+        badFreq = tagBadFreq;
+        susp = newTagSusp;
+        continue;
+      }
 
-          tagGoodIdx = intersect_set(newGoodIdx,
-              goodPositions.tagPositions.value(tags[j].unigram, defaultSet()));
+      ////////////////////
+      // Word expansion //
+      ////////////////////
 
-          tagBadIdx = intersect_set(newBadIdx,
-            badPositions.tagPositions.value(tags[j].unigram, defaultSet()));
+      QVector<Unigram> wordNgram(ngram);
+      wordNgram.push_back(words[j]);
 
-          if (j - i == 1 && (tagGoodIdx->size() > 5 || tagBadIdx->size() > 5)) {
-            Bigram bigram(ngram[0], tags[j]);
-            goodBigramCache[bigram] = tagGoodIdx;
-            badBigramCache[bigram] = tagBadIdx;
-          }
-        }
+      size_t wordGoodFreq = sequenceFreq(goodIndex, wordNgram, true);
+      size_t wordBadFreq = sequenceFreq(badIndex, wordNgram, false);
 
-        double newTagSusp = 0.0;
-        if (tagBadIdx->size() > 0)
-          newTagSusp = static_cast<double>(tagBadIdx->size()) /
-            static_cast<double>(tagBadIdx->size() + tagGoodIdx->size());
+      double newWordSusp = 0.0;
+      if (wordBadFreq > 0)
+        newWordSusp = static_cast<double>(wordBadFreq) /
+          static_cast<double>(wordBadFreq + wordGoodFreq);
 
-        double ef = expansionFactor(tagBadIdx->size());
+      ef = expansionFactor(wordBadFreq);
 
-        QVector<Unigram> secondGram = ngram.mid(1);
-        secondGram.push_back(tags[j]);
-        double susp2 = sequenceRatio(&goodBigramCache, &badBigramCache,
-            goodPositions, badPositions, secondGram);
+      secondGram = ngram.mid(1);
+      secondGram.push_back(words[j]);
+      susp2 = sequenceRatio(goodIndex, badIndex, secondGram);
 
-        if (newTagSusp > susp * ef && newTagSusp > susp2 * ef) {
-          ngram.push_back(tags[j]);
-          goodIdx = tagGoodIdx;
-          badIdx = tagBadIdx;
-          susp = newTagSusp;
-          continue;
-        }
+      if (newWordSusp > susp * ef && newWordSusp > susp2 * ef) {
+        ngram = wordNgram;
+        goodFreq = wordGoodFreq;
+        badFreq = wordBadFreq;
+        susp = newWordSusp;
+        continue;
+      }
 
-        ////////////////////
-        // Word expansion //
-        ////////////////////
-
-        QSharedPointer<IndexSet> wordGoodIdx;
-        QSharedPointer<IndexSet> wordBadIdx;
-
-        fromCache = false;
-        if (ngram.size() == 1) {
-            BigramCache::const_iterator goodIter;
-            BigramCache::const_iterator badIter;
-            Bigram bigram(ngram[0], words[j]);
-            if ((goodIter = goodBigramCache.find(bigram)) !=
-                  goodBigramCache.end() &&
-                (badIter = badBigramCache.find(bigram)) !=
-                badBigramCache.end()) {
-              wordBadIdx = *badIter;
-              wordGoodIdx = *goodIter;
-              fromCache = true;
-            }
-        }
+      break;
+    }
 
-        if (!fromCache) {
-          QSharedPointer<IndexSet> newGoodIdx(new IndexSet);
-          for (IndexSet::const_iterator iter = goodIdx->begin();
-              iter != goodIdx->end(); ++iter)
-            newGoodIdx->insert(*iter + 1);
+    QStringList ngramFlat;
+    for (QVector<Unigram>::const_iterator iter = ngram.begin();
+        iter != ngram.end(); ++iter)
+      ngramFlat.push_back(iter->unigram);
+    QString ngramStr(ngramFlat.join("_"));
 
-          QSharedPointer<IndexSet> newBadIdx(new IndexSet);
-          for (IndexSet::const_iterator iter = badIdx->begin();
-              iter != badIdx->end(); ++iter)
-            newBadIdx->insert(*iter + 1);
+    *sentStream << ngramStr << " ";
+    *formStream << ngramStr << " " << susp << " " << goodFreq <<
+      " " << badFreq << "\n";
+  }
 
-          wordGoodIdx = intersect_set(newGoodIdx,
-            goodPositions.wordPositions.value(words[j].unigram, defaultSet()));
+  *sentStream << "\n";
+}
 
-          wordBadIdx = intersect_set(newBadIdx,
-            badPositions.wordPositions.value(words[j].unigram, defaultSet()));
+/*
+ * Expands a chunk of sentences. The indexes are only read, so chunks
+ * can be expanded by several threads at once.
+ */
+class ExpandChunk {
+public:
+  typedef ExpandedChunk result_type;
 
-          if (j - i == 1 && (wordGoodIdx->size() > 5 || wordBadIdx->size() > 5)) {
-            Bigram bigram(ngram[0], words[j]);
-            goodBigramCache[bigram] = wordGoodIdx;
-            badBigramCache[bigram] = wordBadIdx;
-          }
-        }
+  ExpandChunk(TaggedCorpusIndex const *goodIndex,
+      TaggedCorpusIndex const *badIndex) :
+      d_goodIndex(goodIndex), d_badIndex(badIndex) {}
 
-        double newWordSusp = 0.0;
-        if (wordBadIdx->size() > 0)
-          newWordSusp = static_cast<double>(wordBadIdx->size()) /
-            (wordBadIdx->size() + wordGoodIdx->size());
+  ExpandedChunk operator()(QStringList const &lines) const {
+    ExpandedChunk chunk;
 
-        ef = expansionFactor(wordBadIdx->size());
+    QTextStream sentStream(&chunk.sentences);
+    QTextStream formStream(&chunk.forms);
+    formStream.setRealNumberPrecision(6);
+    formStream.setRealNumberNotation(QTextStream::FixedNotation);
 
-        secondGram = ngram.mid(1);
-        secondGram.push_back(words[j]);
-        susp2 = sequenceRatio(&goodBigramCache, &badBigramCache,
-            goodPositions, badPositions, secondGram);
+    for (QStringList::const_iterator iter = lines.begin();
+        iter != lines.end(); ++iter)
+      expandSentence(*iter, *d_goodIndex, *d_badIndex, &sentStream,
+        &formStream);
 
-        if (newWordSusp > susp * ef && newWordSusp > susp2 * ef) {
-          ngram.push_back(words[j]);
-          goodIdx = wordGoodIdx;
-          badIdx = wordBadIdx;
-          susp = newWordSusp;
-          continue;
-        }
+    sentStream.flush();
+    formStream.flush();
 
-        break;
+    return chunk;
+  }
+
+private:
+  TaggedCorpusIndex const *d_goodIndex;
+  TaggedCorpusIndex const *d_badIndex;
+};
+
+void expandCorpus(QTextStream *corpusStream, TaggedCorpusIndex const &goodIndex,
+    TaggedCorpusIndex const &badIndex, QTextStream *sentStream,
+    QTextStream *formStream)
+{
+  QTextStream err(stderr);
+
+  // Chunks are expanded in waves, so that only a bounded part of the
+  // corpus and of the output is kept in memory.
+  int waveSize = qMax(QThread::idealThreadCount(), 1) * 4;
+
+  bool done = false;
+  while (!done) {
+    QList<QStringList> chunks;
+    while (chunks.size() < waveSize) {
+      QStringList lines;
+      while (lines.size() < CHUNK_SIZE) {
+        QString line = corpusStream->readLine();
+        if (line.isNull()) {
+          done = true;
+          break;
+        }
+        lines.push_back(line);
       }
 
-      QStringList ngramFlat;
-      for (QVector<Unigram>::const_iterator iter = ngram.begin();
-          iter != ngram.end(); ++iter)
-        ngramFlat.push_back(iter->unigram);
-      QString ngramStr(ngramFlat.join("_"));
+      if (!lines.isEmpty())
+        chunks.push_back(lines);
 
-      *sentStream << ngramStr << " ";
-      *formStream << ngramStr << " " << susp << " " << goodIdx->size() <<
-        " " << badIdx->size() << "\n";
+      if (done)
+        break;
     }
 
-    count += 1;
-    if (count % 100 == 0) {
-      QTextStream out(stderr);
-      out << ".";
-     }
-
-     *sentStream << "\n";
+    // The results of mapped() are in the order of the chunks, so the
+    // output is in the order of the corpus.
+    QFuture<ExpandedChunk> expanded = QtConcurrent::mapped(chunks,
+      ExpandChunk(&goodIndex, &badIndex));
+    for (int i = 0; i < chunks.size(); ++i) {
+      ExpandedChunk chunk = expanded.resultAt(i);
+      *sentStream << chunk.sentences;
+      *formStream << chunk.forms;
+
+      if (chunks[i].size() == CHUNK_SIZE) {
+        err << ".";
+        err.flush();
+      }
+    }
   }
 }
 
@@ -413,14 +337,14 @@ int main(int argc, char *argv[]) {
 
   QTextStream err(stderr);
   err << "Constructing indextables..." << endl;
-  Positions goodPositions;
-  readCorpus(goodStream, &goodPositions);
+  TaggedCorpusIndex goodIndex;
+  readCorpus(goodStream, &goodIndex);
 
-  Positions badPositions;
-  readCorpus(badStream, &badPositions);
+  TaggedCorpusIndex badIndex;
+  readCorpus(badStream, &badIndex);
 
   err << "Expanding..." << endl;
   badStream.seek(0);
-  expandCorpus(&badStream, goodPositions, badPositions, &sentStream,
+  expandCorpus(&badStream, goodIndex, badIndex, &sentStream,
     &formStream);
 }
@@ -28,6 +28,15 @@ namespace errormining {
               d_expansionFactorAlpha(expansionFactorAlpha)
               {}
         
+        BestRatioExpander(HashAutomatonPtr parsableHA,
+            HashAutomatonPtr unparsableHA,
+            DynamicSuffixArrayPtr goodSA, DynamicSuffixArrayPtr badSA,
+            size_t n, double expansionFactorAlpha)
+            : Expander(parsableHA, unparsableHA, goodSA, badSA),
+              d_n(n),
+              d_expansionFactorAlpha(expansionFactorAlpha)
+              {}
+        
         virtual ~BestRatioExpander() {}
         
         std::vector<Expansion> operator()(TokensIter begin, TokensIter end);
@@ -0,0 +1,92 @@
+#ifndef ERRORMINING_DYNAMICSUFFIXARRAY_HH
+#define ERRORMINING_DYNAMICSUFFIXARRAY_HH
+
+#include <vector>
+
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+
+#include "SuffixArray.hh"
+
+namespace errormining
+{
+
+/**
+ * A suffix array that can grow. It consists of a base suffix array and
+ * suffix arrays of data that was added later (deltas). Lookups sum the
+ * frequencies over all segments. To keep the number of segments
+ * logarithmic in the amount of added data, the most recent segments are
+ * merged in the background as soon as they are together at least as
+ * large as the segment that precedes them. The base suffix array is
+ * never merged. Lookups can be performed while a merge is running.
+ *
+ * Sequences that cross the border between two segments are never
+ * counted. Merged segments are separated by a delimiter, so frequencies
+ * do not depend on which segments were merged.
+ */
+class DynamicSuffixArray
+{
+public:
+	typedef QSharedPointer<SuffixArray<int> const> SegmentPtr;
+
+	/**
+	 * Construct a dynamic suffix array.
+	 *
+	 * @param base The suffix array of the initial data.
+	 */
+	DynamicSuffixArray(SegmentPtr base);
+
+	/**
+	 * Destruct the suffix array, after waiting for a running merge.
+	 */
+	~DynamicSuffixArray();
+
+	/**
+	 * Add the suffix array of new data.
+	 */
+	void add(SegmentPtr delta);
+
+	/**
+	 * Return the number of occurrences of a sequence in all segments.
+	 */
+	size_t frequency(std::vector<int>::const_iterator begin,
+		std::vector<int>::const_iterator end) const;
+
+	/**
+	 * Return the number of segments.
+	 */
+	size_t nSegments() const;
+
+	/**
+	 * Wait until all merges are finished.
+	 */
+	void waitForMerges();
+private:
+	DynamicSuffixArray(DynamicSuffixArray const &other);
+	DynamicSuffixArray &operator=(DynamicSuffixArray const &other);
+
+	// Start a merge if the newest segments should be merged, and no merge
+	// is running. Called with d_mergeMutex locked.
+	void scheduleMerge();
+
+	// Merge a contiguous range of segments, starting at segment 'first',
+	// and replace them by the merged segment.
+	static void merge(DynamicSuffixArray *suffixArray, int first,
+		QList<SegmentPtr> segments);
+
+	mutable QReadWriteLock d_segmentsLock;
+	QList<SegmentPtr> d_segments;
+
+	QMutex d_mergeMutex;
+	bool d_merging;
+	QFuture<void> d_merge;
+};
+
+typedef QSharedPointer<DynamicSuffixArray> DynamicSuffixArrayPtr;
+
+}
+
+#endif // ERRORMINING_DYNAMICSUFFIXARRAY_HH
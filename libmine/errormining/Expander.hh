@@ -8,6 +8,7 @@
 #include <QHash>
 #include <QSharedPointer>
 
+#include "DynamicSuffixArray.hh"
 #include "HashAutomaton.hh"
 #include "SuffixArray.hh"
 
@@ -23,7 +24,8 @@ namespace errormining {
 
     /**
      * This struct represents an expansion. An expander could choose to expand a unigram
-     * to a longer n-gram. An n-gram is represented as an iterator pair.
+     * to a longer n-gram. An n-gram is represented as an iterator pair, or, if it is
+     * not a subsequence of the sentence, by its own tokens.
      */
     struct Expansion
     {
@@ -34,7 +36,18 @@ namespace errormining {
           parsableFreq(newParsableFreq),
           unparsableFreq(newUnparsableFreq) {}
         
+        Expansion(Tokens const &newNgram,
+            size_t newParsableFreq,
+            size_t newUnparsableFreq)
+        : ngram(newNgram),
+          parsableFreq(newParsableFreq),
+          unparsableFreq(newUnparsableFreq) {}
+        
         TokensIterPair iters;
+        
+        // The tokens of the n-gram, empty if the n-gram is given by iters.
+        Tokens ngram;
+        
         size_t parsableFreq;
         size_t unparsableFreq;
     };
@@ -54,6 +67,18 @@ namespace errormining {
           d_badSuffixArray(badSA),
           d_freqCache(new QCache<std::vector<int>, std::pair<size_t, size_t> >(1000000)) {}
         
+        /**
+         * Construct an expander that looks up frequencies in suffix arrays
+         * that can grow. Call clearCache() after data was added.
+         */
+        Expander(HashAutomatonPtr parsableHA, HashAutomatonPtr unparsableHA,
+                 DynamicSuffixArrayPtr goodSA, DynamicSuffixArrayPtr badSA)
+        : d_parsableHashAutomaton(parsableHA),
+          d_unparsableHashAutomaton(unparsableHA),
+          d_goodDynamicSuffixArray(goodSA),
+          d_badDynamicSuffixArray(badSA),
+          d_freqCache(new QCache<std::vector<int>, std::pair<size_t, size_t> >(1000000)) {}
+        
         virtual ~Expander() {}
         
         /**
@@ -65,8 +90,23 @@ namespace errormining {
          */
         virtual std::vector<Expansion> operator()(TokensIter begin,
             TokensIter end) = 0;
+        
+        /**
+         * Discard cached frequencies. This is required when data was
+         * added to the suffix arrays.
+         */
+        void clearCache();
 
     protected:
+        /**
+         * Construct an expander that does not look up frequencies in the
+         * suffix arrays of the hashed corpora, ngramFreqs() can not be used.
+         */
+        Expander(HashAutomatonPtr parsableHA, HashAutomatonPtr unparsableHA)
+        : d_parsableHashAutomaton(parsableHA),
+          d_unparsableHashAutomaton(unparsableHA),
+          d_freqCache(new QCache<std::vector<int>, std::pair<size_t, size_t> >(1000000)) {}
+        
         // Retrieve the parsable/unparsable frequencies of an n-gram.
         std::pair<size_t, size_t> ngramFreqs(TokensIter const &ngramBegin,
                                              TokensIter const &ngramEnd) const;
@@ -77,14 +117,36 @@ namespace errormining {
                                              TokensIter const &unparsableNgramBegin,
                                              TokensIter const &unparsableNgramEnd) const;
         
+        // The cache of parsable/unparsable frequencies of n-grams. Subclasses
+        // that do not use ngramFreqs() can use it for their own n-grams.
+        QCache<std::vector<int>, std::pair<size_t, size_t> > *freqCache() const;
+        
+        // The hash automaton of the tokens of unparsable sentences.
+        HashAutomatonPtr unparsableHashAutomaton() const;
+        
     private:
         HashAutomatonPtr d_parsableHashAutomaton;
         HashAutomatonPtr d_unparsableHashAutomaton;
+        
+        // Only one pair of suffix arrays is used. Static suffix arrays are
+        // looked up directly, to avoid the locking of dynamic suffix arrays.
         SuffixArrayPtr d_goodSuffixArray;
         SuffixArrayPtr d_badSuffixArray;
+        DynamicSuffixArrayPtr d_goodDynamicSuffixArray;
+        DynamicSuffixArrayPtr d_badDynamicSuffixArray;
         QSharedPointer<QCache<std::vector<int>, std::pair<size_t, size_t> > > d_freqCache;
     };
 
+    inline QCache<std::vector<int>, std::pair<size_t, size_t> > *Expander::freqCache() const
+    {
+        return d_freqCache.data();
+    }
+
+    inline HashAutomatonPtr Expander::unparsableHashAutomaton() const
+    {
+        return d_unparsableHashAutomaton;
+    }
+
 }
 
 namespace std {
@@ -9,6 +9,19 @@
 namespace errormining
 {
 
+/**
+ * The type used to store the suspicions of forms and the per-cycle
+ * suspicion sums. On very large data sets, mining is bound by memory
+ * bandwidth, so these can be stored in single precision by defining
+ * ERRORMINING_FLOAT_SUSPICION. Sums over the observations of a sentence
+ * and over all forms are always accumulated in double precision.
+ */
+#ifdef ERRORMINING_FLOAT_SUSPICION
+typedef float Suspicion;
+#else
+typedef double Suspicion;
+#endif
+
 /**
  * This class represents a form, which is normally an n-gram.
  */
@@ -24,8 +37,9 @@ public:
 	Form(std::vector<int> const &ngram, double suspicion = 0.0,
 			size_t unsuspObservations = 0, size_t suspObservations = 0)
 		: d_ngram(new std::vector<int>(ngram)),
-		d_suspicion(suspicion), d_unsuspObservations(unsuspObservations),
-		d_suspObservations(suspObservations)
+		d_unsuspObservations(unsuspObservations),
+		d_suspObservations(suspObservations), d_suspicion(suspicion),
+		d_cycleSuspicion(0.0)
 		{}
 
 	Form(Form const &other);
@@ -33,6 +47,23 @@ public:
 	bool operator==(Form const &rhs) const;
 	bool operator<(Form const &rhs) const;
 
+	/**
+	 * Add the suspicion of an observation to the cycle suspicion.
+	 */
+	void addCycleSuspicion(double suspicion);
+
+	/**
+	 * Register a number of unsuspicious observations.
+	 */
+	void addUnsuspObservations(size_t n);
+
+	/**
+	 * Return the cycle suspicion. The miner uses this value during a
+	 * mining cycle, to sum the suspicions of the observations of this
+	 * form, and to remember its suspicion of the previous cycle.
+	 */
+	double cycleSuspicion() const;
+
 	/**
 	 * Return the total number of observations (suspicious and unsuspicous)
 	 * of this form.
@@ -70,6 +101,11 @@ public:
 	 */
 	void removeSuspObservation();
 
+	/**
+	 * Set the cycle suspicion of this form.
+	 */
+	void setCycleSuspicion(double suspicion);
+
 	/**
 	 * Set the suspicion of this form.
 	 */
@@ -83,9 +119,10 @@ private:
 	void copy(Form const &other);
 
         QSharedPointer<std::vector<int> > d_ngram;
-	double d_suspicion;
         size_t d_unsuspObservations;
 	size_t d_suspObservations;
+	Suspicion d_suspicion;
+	Suspicion d_cycleSuspicion;
 };
 
 /**
@@ -120,6 +157,21 @@ inline Form::Form(Form const &other)
 	copy(other);
 }
 
+inline void Form::addCycleSuspicion(double suspicion)
+{
+	d_cycleSuspicion += static_cast<Suspicion>(suspicion);
+}
+
+inline void Form::addUnsuspObservations(size_t n)
+{
+	d_unsuspObservations += n;
+}
+
+inline double Form::cycleSuspicion() const
+{
+	return d_cycleSuspicion;
+}
+
 inline size_t Form::nObservations() const
 {
 	return d_unsuspObservations + d_suspObservations;
@@ -155,9 +207,14 @@ inline void Form::removeSuspObservation()
 	--d_suspObservations;
 }
 
+inline void Form::setCycleSuspicion(double suspicion)
+{
+	d_cycleSuspicion = static_cast<Suspicion>(suspicion);
+}
+
 inline void Form::setSuspicion(double suspicion)
 {
-	d_suspicion = suspicion;
+	d_suspicion = static_cast<Suspicion>(suspicion);
 }
 
 inline double Form::suspicion() const
@@ -0,0 +1,99 @@
+#ifndef ERRORMINING_FORMSENTENCEINCIDENCE_HH
+#define ERRORMINING_FORMSENTENCEINCIDENCE_HH
+
+#include <utility>
+#include <vector>
+
+#include <QtGlobal>
+
+namespace errormining
+{
+
+/**
+ * The sentences in which forms occur, stored in compressed sparse row
+ * format: the sentences of all forms are stored in one array, ordered
+ * by form, and an offset array gives the start of every form. Forms
+ * and sentences are identified by numbers, that do not need to be
+ * dense. For every sentence, it is also stored whether it is
+ * unparsable.
+ */
+class FormSentenceIncidence
+{
+public:
+	typedef std::pair<quint32, quint32> Link;
+
+	/**
+	 * Construct the incidence structure.
+	 *
+	 * @param links Pairs of form and sentence numbers, in any order.
+	 * @param unparsable For every sentence number, whether the sentence
+	 *  is unparsable. Sentences that are not in this vector are
+	 *  considered to be parsable.
+	 */
+	FormSentenceIncidence(std::vector<Link> const &links,
+		std::vector<bool> const &unparsable);
+
+	/**
+	 * Return the number of unparsable sentences.
+	 */
+	size_t nUnparsable() const;
+
+	/**
+	 * Return the number of sentences, this is the largest sentence number
+	 * plus one.
+	 */
+	size_t nSentences() const;
+
+	/**
+	 * Return a pointer to the first sentence in which a form occurs.
+	 */
+	quint32 const *sentencesBegin(size_t form) const;
+
+	/**
+	 * Return a pointer beyond the last sentence in which a form occurs.
+	 */
+	quint32 const *sentencesEnd(size_t form) const;
+
+	/**
+	 * Return true if the sentence is unparsable.
+	 */
+	bool unparsable(size_t sentence) const;
+private:
+	std::vector<quint32> d_offsets;
+	std::vector<quint32> d_sentences;
+	std::vector<bool> d_unparsable;
+	size_t d_nUnparsable;
+};
+
+inline size_t FormSentenceIncidence::nUnparsable() const
+{
+	return d_nUnparsable;
+}
+
+inline size_t FormSentenceIncidence::nSentences() const
+{
+	return d_unparsable.size();
+}
+
+inline quint32 const *FormSentenceIncidence::sentencesBegin(size_t form) const
+{
+	if (form + 1 >= d_offsets.size())
+		return 0;
+	return (d_sentences.empty() ? 0 : &d_sentences[0]) + d_offsets[form];
+}
+
+inline quint32 const *FormSentenceIncidence::sentencesEnd(size_t form) const
+{
+	if (form + 1 >= d_offsets.size())
+		return 0;
+	return (d_sentences.empty() ? 0 : &d_sentences[0]) + d_offsets[form + 1];
+}
+
+inline bool FormSentenceIncidence::unparsable(size_t sentence) const
+{
+	return d_unparsable[sentence];
+}
+
+}
+
+#endif // ERRORMINING_FORMSENTENCEINCIDENCE_HH
@@ -30,17 +30,31 @@ public:
 		d_parsableHashAutomaton(parsableHashAutomaton),
 		d_unparsableHashAutomaton(unparsableHashAutomaton),
 		d_goodCorpus(new std::vector<int>),
-		d_badCorpus(new std::vector<int>) {}
+		d_badCorpus(new std::vector<int>),
+		d_goodSentenceStarts(new std::vector<size_t>),
+		d_badSentenceStarts(new std::vector<size_t>) {}
 
 	/**
 	 * Get the corpus of unparsable sentences.
 	 */
 	QSharedPointer<std::vector<int> const> bad() const;
 
+	/**
+	 * Get the start positions of the sentences in the corpus of
+	 * unparsable sentences.
+	 */
+	QSharedPointer<std::vector<size_t> const> badSentenceStarts() const;
+
 	/**
 	 * Get the corpus of parsable sentences.
 	 */
 	QSharedPointer<std::vector<int> const> good() const;
+
+	/**
+	 * Get the start positions of the sentences in the corpus of parsable
+	 * sentences.
+	 */
+	QSharedPointer<std::vector<size_t> const> goodSentenceStarts() const;
 	void handleSentence(std::vector<std::string> const &tokens,
 			double error);
 private:
@@ -50,6 +64,8 @@ private:
 	QSharedPointer<HashAutomaton const> d_unparsableHashAutomaton;
 	QSharedPointer<std::vector<int> > d_goodCorpus;
 	QSharedPointer<std::vector<int> > d_badCorpus;
+	QSharedPointer<std::vector<size_t> > d_goodSentenceStarts;
+	QSharedPointer<std::vector<size_t> > d_badSentenceStarts;
 };
 
 inline QSharedPointer<std::vector<int> const> HashedCorpus::bad() const
@@ -57,11 +73,21 @@ inline QSharedPointer<std::vector<int> const> HashedCorpus::bad() const
 	return d_badCorpus;
 }
 
+inline QSharedPointer<std::vector<size_t> const> HashedCorpus::badSentenceStarts() const
+{
+	return d_badSentenceStarts;
+}
+
 inline QSharedPointer<std::vector<int> const> HashedCorpus::good() const
 {
 	return d_goodCorpus;
 }
 
+inline QSharedPointer<std::vector<size_t> const> HashedCorpus::goodSentenceStarts() const
+{
+	return d_goodSentenceStarts;
+}
+
 }
 
 #endif // HASHCORPUS_HH_
@@ -56,6 +56,15 @@ struct FormProbComp {
 	bool operator()(Form const &lhs, Form const &rhs) const;
 };
 
+/**
+ * Function objects of this type compare two form pointers by the
+ * suspicion of the forms they point to, using the same order as
+ * FormProbComp.
+ */
+struct FormPtrProbComp {
+	bool operator()(Form const *lhs, Form const *rhs) const;
+};
+
 /**
  * Function objects of this type will add the suspicion of a form to
  * a (accumulated) value. To be used with std::accumulator().
@@ -97,17 +106,54 @@ public:
         d_unparsableHashAutomaton(unparsableHashAutomaton),
         d_expander(expander),
 		d_smoothing(smoothing), d_smoothingBeta(smoothingBeta),
+		d_checkpointInterval(0),
 		d_forms(new QSet<FormPtr>()),
 		d_sentences(new std::list<Sentence>()),
         d_ratioCache(new QCache<QVector<int>, double>(1000000)) {}
 
+	/**
+	 * Construct a miner with a deep copy of the forms, sentences and
+	 * suspicions of another miner. This allows for mining the results of
+	 * one expansion with different parameters. Observers and checkpoint
+	 * settings are not copied.
+	 */
+	Miner(Miner const &other);
+
 	~Miner();
 
+	/**
+	 * Return the form with the given n-gram, or 0 if the form is not known
+	 * to this miner.
+	 */
+	Form const *form(std::vector<int> const &ngram) const;
+
 	/**
 	 * Return the set of forms known to this miner.
 	 */
 	std::set<Form, FormProbComp> forms() const;
 
+	/**
+	 * Return the number of forms known to this miner.
+	 */
+	size_t nForms() const;
+
+	/**
+	 * Return the unparsable sentences known to this miner, as the
+	 * forms that were observed in them.
+	 */
+	std::list<Sentence> const &sentences() const;
+
+	/**
+	 * Return the forms that were observed at least <i>minFreq</i> times,
+	 * and at least <i>minSuspFreq</i> times in unparsable sentences,
+	 * ordered by descending suspicion. If <i>topK</i> is not 0, only
+	 * the <i>topK</i> most suspicious of these forms are returned.
+	 * Forms are not copied, so the pointers are only valid until the
+	 * miner is modified or destroyed.
+	 */
+	std::vector<Form const *> suspiciousForms(size_t minFreq = 0,
+		size_t minSuspFreq = 0, size_t topK = 0) const;
+
 	/**
 	 * Handle a sentence. This means that forms are extracted, and that a
 	 * representation of the sentence (if error > 0.0) is kept.
@@ -127,24 +173,96 @@ public:
 	 *  analysis.
 	 */
 	void mine(double threshold = 0.001, double suspThreshold = 0.0);
+
+	/**
+	 * Continue mining after new unparsable sentences were added with
+	 * handleSentence(). The current suspicions are used as the starting
+	 * point, forms that were added since the last mining run get an
+	 * initial suspicion as in the first cycle of mine(). The parameters
+	 * are the same as for mine().
+	 */
+	void update(double threshold = 0.001, double suspThreshold = 0.0);
+
+	/**
+	 * Register the observations of the known forms in a batch of new
+	 * parsable sentences. Call this before adding the unparsable sentences
+	 * of the same batch, forms that are created from these sentences get
+	 * their parsable frequency from the expander.
+	 * @param batch The suffix array of the new parsable sentences, hashed
+	 *  with the parsable hash automaton.
+	 */
+	void addParsableSentences(SuffixArray<int> const &batch);
+
+	/**
+	 * Remove forms, and their observations in sentences. Returns the
+	 * number of forms that were removed. The suspicions of the remaining
+	 * forms are not changed until the next call to mine().
+	 */
+	size_t removeForms(std::vector<std::vector<int> > const &ngrams);
+
+	/**
+	 * Continue mining from a state that was restored with
+	 * readCheckpoint(). The parameters are the same as for mine().
+	 */
+	void resume(double threshold = 0.001, double suspThreshold = 0.0);
+
+	/**
+	 * Restore the forms, sentences and suspicions of this miner from
+	 * a checkpoint. Forms and sentences known to the miner are discarded.
+	 * Throws std::runtime_error if the checkpoint could not be read.
+	 */
+	void readCheckpoint(std::string const &filename);
+
+	/**
+	 * Write a checkpoint before the first mining cycle, every
+	 * <i>interval</i> mining cycles, and when the fixed point is
+	 * reached. The checkpoint is written to a temporary file first, and
+	 * then renamed to <i>filename</i>, so that an interrupted write does
+	 * not destroy the previous checkpoint. An interval of 0 disables
+	 * checkpointing.
+	 */
+	void setCheckpoint(std::string const &filename, size_t interval);
+
+	/**
+	 * Enable or disable smoothing, and set the smoothing beta. This
+	 * takes effect in the next call to mine() or resume().
+	 */
+	void setSmoothing(bool smoothing, double smoothingBeta = 0.1);
+
+	/**
+	 * Write the forms, the observations of forms in sentences, and the
+	 * current suspicions to a binary checkpoint file. Throws
+	 * std::runtime_error if the checkpoint could not be written.
+	 */
+	void writeCheckpoint(std::string const &filename) const;
 private:
 	typedef std::pair<std::vector<int>::const_iterator,
 		std::vector<int>::const_iterator> IntVecIterPair;
 
-	// Implementing a copy constructor and assignment operator does not really seem
-	// worth the effort.
-	Miner(Miner const &other);
+	// Implementing an assignment operator does not really seem worth the
+	// effort.
 	Miner &operator=(Miner const &other);
 
 	// Form deallocation.
 	void destroy();
 
+	// Reset the cycle suspicions of all forms.
+	void clearCycleSuspicions();
+
 	// Perform the first mining cycle.
 	void calculateInitialFormSuspicions(double suspThreshold = 0.0);
 
+	// Give forms that were added since the last mining run their initial
+	// suspicion.
+	void calculateNewFormSuspicions();
+
 	// Perform a mining cycle.
 	double calculateFormSuspicions(double suspThreshold = 0.0);
 
+	// Cycle until the fixed-point is reached, writing checkpoints if
+	// requested.
+	void cycle(double threshold, double suspThreshold);
+
 	// Traditional ngram collections (add all n to m-grams).
 	// Sentence collectNgrams(double error, std::vector<int> const &hashedTokens);
 
@@ -168,8 +286,11 @@ private:
     ExpanderPtr d_expander;
 	bool d_smoothing;
 	double d_smoothingBeta;
+	std::string d_checkpointFilename;
+	size_t d_checkpointInterval;
 	QSharedPointer<FormPtrSet> d_forms;
 	QSharedPointer<std::list<Sentence> > d_sentences;
+	std::vector<Form *> d_newForms;
     QSharedPointer<QCache<QVector<int>, double> > d_ratioCache;
 };
 
@@ -178,6 +299,16 @@ inline bool operator==(FormPtr lhs, FormPtr rhs)
 	return *lhs.value == *rhs.value;
 }
 
+inline size_t Miner::nForms() const
+{
+	return d_forms->size();
+}
+
+inline std::list<Sentence> const &Miner::sentences() const
+{
+	return *d_sentences;
+}
+
 inline double FormPtrSuspSum::operator()(double acc, FormPtr const formPtr) const
 {
 	return acc + formPtr.value->suspicion();
@@ -188,6 +319,18 @@ inline Miner::~Miner()
 	destroy();
 }
 
+inline void Miner::setCheckpoint(std::string const &filename, size_t interval)
+{
+	d_checkpointFilename = filename;
+	d_checkpointInterval = interval;
+}
+
+inline void Miner::setSmoothing(bool smoothing, double smoothingBeta)
+{
+	d_smoothing = smoothing;
+	d_smoothingBeta = smoothingBeta;
+}
+
 }
 
 template <typename T>
@@ -0,0 +1,178 @@
+#ifndef ERRORMINING_MININGRESULTS_HH
+#define ERRORMINING_MININGRESULTS_HH
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QtGlobal>
+
+namespace errormining
+{
+
+/**
+ * This exception is thrown when a mining results file could not be
+ * read or written.
+ */
+class MiningResultsException : public std::runtime_error
+{
+public:
+	MiningResultsException(std::string const &what) :
+		std::runtime_error(what) {}
+};
+
+/**
+ * Mining results, stored in columns: a vocabulary, an arena with the
+ * tokens of all n-grams (as indices in the vocabulary), and suspicion,
+ * frequency and unparsable frequency columns. Forms are kept in the
+ * order in which they were added, normally by descending suspicion.
+ *
+ * Results can be stored in a compact binary format, that can be read
+ * without any parsing. The traditional text format, with one form per
+ * line:
+ *
+ * [ngram] [suspicion] [f(ngram)] [f_unparsable(ngram)]
+ *
+ * can be read and written as well.
+ */
+class MiningResults
+{
+public:
+	/**
+	 * Construct an empty set of results.
+	 */
+	MiningResults() : d_ngramOffsets(1, 0) {}
+
+	/**
+	 * Construct an empty set of results, with the given vocabulary. The
+	 * n-grams of forms added with addForm() are indices into this
+	 * vocabulary.
+	 */
+	MiningResults(std::vector<std::string> const &vocabulary) :
+		d_vocabulary(vocabulary), d_ngramOffsets(1, 0) {}
+
+	/**
+	 * Add a form.
+	 *
+	 * @param ngram The n-gram, as indices into the vocabulary.
+	 */
+	void addForm(std::vector<int> const &ngram, double suspicion,
+		size_t freq, size_t suspFreq);
+
+	/**
+	 * Return the form with the given index, with tokens separated by
+	 * spaces.
+	 */
+	std::string form(size_t index) const;
+
+	/**
+	 * Return the number of observations of the form with the given index.
+	 */
+	size_t freq(size_t index) const;
+
+	/**
+	 * Return the length of the n-gram of the form with the given index.
+	 */
+	size_t ngramLength(size_t index) const;
+
+	/**
+	 * Return the tokens of the form with the given index, as indices into
+	 * the vocabulary.
+	 */
+	quint32 const *ngram(size_t index) const;
+
+	/**
+	 * Read results, the format (binary or text) is detected automatically.
+	 */
+	void read(std::string const &filename);
+
+	/**
+	 * Return the number of forms.
+	 */
+	size_t size() const;
+
+	/**
+	 * Return the suspicion of the form with the given index.
+	 */
+	double suspicion(size_t index) const;
+
+	/**
+	 * Return the number of observations in unparsable sentences of the
+	 * form with the given index.
+	 */
+	size_t suspFreq(size_t index) const;
+
+	/**
+	 * Return the vocabulary.
+	 */
+	std::vector<std::string> const &vocabulary() const;
+
+	/**
+	 * Write results in the binary format.
+	 */
+	void write(std::string const &filename) const;
+
+	/**
+	 * Write results in the text format.
+	 */
+	void writeText(std::ostream &out) const;
+
+	/**
+	 * Check whether a file is in the binary results format.
+	 */
+	static bool isBinary(std::string const &filename);
+private:
+	void readBinary(std::istream &in);
+	void readText(std::istream &in);
+
+	std::vector<std::string> d_vocabulary;
+	std::vector<quint64> d_ngramOffsets;
+	std::vector<quint32> d_tokens;
+	std::vector<double> d_suspicions;
+	std::vector<quint64> d_freqs;
+	std::vector<quint64> d_suspFreqs;
+};
+
+inline size_t MiningResults::freq(size_t index) const
+{
+	return d_freqs[index];
+}
+
+inline size_t MiningResults::ngramLength(size_t index) const
+{
+	return d_ngramOffsets[index + 1] - d_ngramOffsets[index];
+}
+
+inline quint32 const *MiningResults::ngram(size_t index) const
+{
+	// The token arena is empty if the results are, or if all forms are
+	// empty n-grams.
+	if (d_tokens.empty())
+		return 0;
+	return &d_tokens[0] + d_ngramOffsets[index];
+}
+
+inline size_t MiningResults::size() const
+{
+	return d_suspicions.size();
+}
+
+inline double MiningResults::suspicion(size_t index) const
+{
+	return d_suspicions[index];
+}
+
+inline size_t MiningResults::suspFreq(size_t index) const
+{
+	return d_suspFreqs[index];
+}
+
+inline std::vector<std::string> const &MiningResults::vocabulary() const
+{
+	return d_vocabulary;
+}
+
+}
+
+#endif // ERRORMINING_MININGRESULTS_HH
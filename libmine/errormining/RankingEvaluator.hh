@@ -0,0 +1,62 @@
+#ifndef ERRORMINING_RANKINGEVALUATOR_HH
+#define ERRORMINING_RANKINGEVALUATOR_HH
+
+#include <vector>
+
+#include "FormSentenceIncidence.hh"
+
+namespace errormining
+{
+
+/**
+ * A point of an evaluation curve: the recall, precision and F-scores
+ * after taking the first forms of a ranking.
+ */
+struct EvaluationPoint
+{
+	double recall;
+	double precision;
+	double fscore;
+	double betaFscore;
+};
+
+/**
+ * Evaluates a ranking of forms incrementally. The sentences that are
+ * covered by the forms that were added so far are kept in a bit set, so
+ * every form is only visited once. Recall is the fraction of unparsable
+ * sentences that are covered, precision is the fraction of covered
+ * sentences that is unparsable.
+ */
+class RankingEvaluator
+{
+public:
+	/**
+	 * Construct an evaluator.
+	 *
+	 * @param incidence The sentences in which the forms occur.
+	 * @param beta The beta of the weighted F-score.
+	 */
+	RankingEvaluator(FormSentenceIncidence const &incidence,
+		double beta = 0.5);
+
+	/**
+	 * Add the next form of the ranking, and return the evaluation of the
+	 * ranking so far.
+	 */
+	EvaluationPoint add(size_t form);
+
+	/**
+	 * Start evaluating a new ranking.
+	 */
+	void reset();
+private:
+	FormSentenceIncidence const *d_incidence;
+	double d_betaSquare;
+	std::vector<bool> d_found;
+	size_t d_parsableFound;
+	size_t d_unparsableFound;
+};
+
+}
+
+#endif // ERRORMINING_RANKINGEVALUATOR_HH
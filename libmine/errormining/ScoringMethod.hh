@@ -2,6 +2,7 @@
 #define SCORING_HH
 
 #include <cmath>
+#include <string>
 
 #include <QSharedPointer>
 
@@ -14,6 +15,42 @@ enum ScoringMethod { SCORING_SUSP, SCORING_SUSP_OBS, SCORING_SUSP_UNIQSENTS,
     SCORING_SUSP_LN_OBS, SCORING_SUSP_LN_UNIQSENTS, SCORING_SUSP_DELTA,
     SCORING_SUSP_LN_DELTA};
 
+/**
+ * The name and description of a scoring method, and the column of the
+ * forms table in a mining database that stores its scores.
+ */
+struct ScoringMethodInfo
+{
+	ScoringMethod method;
+	char const *name;
+	char const *column;
+	char const *description;
+};
+
+/**
+ * All scoring methods, tools that evaluate or list all scoring methods
+ * use this table.
+ */
+extern ScoringMethodInfo const SCORING_METHODS[];
+extern size_t const N_SCORING_METHODS;
+
+/**
+ * Find a scoring method by its name. Returns false if there is no
+ * scoring method with the given name.
+ */
+bool scoringMethodByName(std::string const &name, ScoringMethod *method);
+
+/**
+ * Return the name of a scoring method.
+ */
+std::string scoringMethodName(ScoringMethod method);
+
+/**
+ * Return the column of the forms table in a mining database that stores
+ * the scores of a scoring method.
+ */
+std::string scoringMethodColumn(ScoringMethod method);
+
 struct ScoreFun
 {
 	virtual ~ScoreFun() {}
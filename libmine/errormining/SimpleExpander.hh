@@ -23,6 +23,13 @@ namespace errormining {
           d_n(n), d_m(m),
           d_freqCache(new QCache<std::vector<int>, std::pair<size_t, size_t> >(1000000)) {}
         
+        SimpleExpander(HashAutomatonPtr parsableHA, HashAutomatonPtr unparsableHA,
+            DynamicSuffixArrayPtr goodSA, DynamicSuffixArrayPtr badSA,
+            size_t n, size_t m)
+        : Expander(parsableHA, unparsableHA, goodSA, badSA),
+          d_n(n), d_m(m),
+          d_freqCache(new QCache<std::vector<int>, std::pair<size_t, size_t> >(1000000)) {}
+        
         virtual ~SimpleExpander() {}
         
         std::vector<Expansion> operator()(TokensIter begin, TokensIter end);
@@ -62,8 +62,8 @@ public:
 	 *  for the suffix array.
 	 */
 	SuffixArray(QSharedPointer<std::vector<T> const> const &data) :
-		d_data(data), d_suffixArray(genSuffixArray(*d_data)),
-		d_compareFun(SuffixCompare<T>(d_data.get())) {}
+		d_data(data), d_compareFun(SuffixCompare<T>(d_data.data())),
+		d_suffixArray(genSuffixArray(*d_data)) {}
 
 	/**
 	 * Specialized constructor for data arrays of type <i>vector&lt;int&gt;</i>.
@@ -79,8 +79,8 @@ public:
 	SuffixArray(QSharedPointer<std::vector<int> const> const &data,
 			SortAlgorithm sortAlgorithm) :
 		d_data(data),
-		d_suffixArray(genSuffixArray(*d_data, sortAlgorithm)),
-		d_compareFun(SuffixCompare<int>(d_data.data())) {}
+		d_compareFun(SuffixCompare<int>(d_data.data())),
+		d_suffixArray(genSuffixArray(*d_data, sortAlgorithm)) {}
 
 	/**
 	 * Recreate a suffix array from a previously created suffix array vector.
@@ -88,16 +88,16 @@ public:
 	SuffixArray(std::vector<T> const &data,
 			std::vector<size_t> const &suffixArray) :
 		d_data(new std::vector<T>(data)),
-		d_suffixArray(new std::vector<size_t>(suffixArray)),
-		d_compareFun(SuffixCompare<T>(d_data.get())) {}
+		d_compareFun(SuffixCompare<T>(d_data.data())),
+		d_suffixArray(new std::vector<size_t>(suffixArray)) {}
 
 	/**
 	 * Copy constructor.
 	 */
 	SuffixArray<T>(SuffixArray<T> const &other) :
 		d_data(new std::vector<T>(*(other.d_data))),
-		d_suffixArray(new std::vector<size_t>(*other.d_suffixArray)),
-		d_compareFun(SuffixCompare<T>(d_data.get())) {}
+		d_compareFun(SuffixCompare<T>(d_data.data())),
+		d_suffixArray(new std::vector<size_t>(*other.d_suffixArray)) {}
 
 	SuffixArray &operator=(SuffixArray<T> const &other);
 
@@ -135,9 +135,11 @@ private:
 	std::vector<size_t> const *genSuffixArray(std::vector<int> const &data,
 			SortAlgorithm sortAlgorithm) const;
 
+	// The comparison function is used to generate the suffix array, so
+	// it must be initialized first.
 	QSharedPointer<std::vector<T> const> d_data;
-	QSharedPointer<std::vector<size_t> const> d_suffixArray;
 	SuffixCompare<T> d_compareFun;
+	QSharedPointer<std::vector<size_t> const> d_suffixArray;
 };
 
 template <typename T>
@@ -146,7 +148,7 @@ SuffixArray<T> &SuffixArray<T>::operator=(SuffixArray<T> const &other)
 	if (this != &other) {
 		d_data = QSharedPointer<std::vector<T> >(new std::vector<T>(*other.d_data));
 		d_suffixArray = QSharedPointer<std::vector<size_t> >(new std::vector<size_t>(*other.d_suffixArray));
-		d_compareFun = SuffixCompare<T>(d_data.get());
+		d_compareFun = SuffixCompare<T>(d_data.data());
 	}
 
 	return *this;
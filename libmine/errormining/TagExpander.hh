@@ -0,0 +1,102 @@
+#ifndef ERRORMINING_TAGEXPANDER_HH
+#define ERRORMINING_TAGEXPANDER_HH
+
+#include <string>
+#include <vector>
+
+#include <QHash>
+#include <QSharedPointer>
+
+#include "Expander.hh"
+#include "TaggedCorpusIndex.hh"
+
+namespace errormining {
+    typedef QSharedPointer<TaggedCorpusIndex const> TaggedCorpusIndexPtr;
+
+    /**
+     * Expander that expands an n-gram of words with the words or the
+     * part-of-speech tags that follow it, giving n-grams of mixed words
+     * and tags. The tokens of sentences are of the form word/tag, and the
+     * unparsable hash automaton should contain these tokens.
+     *
+     * An n-gram is expanded with the tag of the next token if the expanded
+     * n-gram is more suspect than both of its n-grams, as in the
+     * BestRatioExpander, and otherwise with the word of the next token if
+     * that n-gram is. Frequencies are looked up in indexes of the tagged
+     * parsable and unparsable corpora.
+     *
+     * The items of the n-grams in expansions are encoded as integers, use
+     * itemString() to decode them.
+     */
+    class TagExpander : public Expander
+    {
+    public:
+        TagExpander(HashAutomatonPtr parsableHA,
+            HashAutomatonPtr unparsableHA,
+            TaggedCorpusIndexPtr goodIndex, TaggedCorpusIndexPtr badIndex,
+            size_t n, double expansionFactorAlpha)
+            : Expander(parsableHA, unparsableHA),
+              d_goodIndex(goodIndex),
+              d_badIndex(badIndex),
+              d_n(n),
+              d_expansionFactorAlpha(expansionFactorAlpha) {}
+
+        virtual ~TagExpander() {}
+
+        std::vector<Expansion> operator()(TokensIter begin, TokensIter end);
+
+        // Calculate the expansion factor of an n-gram.
+        double expansionFactor(size_t unparsableFreq) const;
+
+        /**
+         * Return the word or tag that an item of an expanded n-gram
+         * represents.
+         */
+        std::string const &itemString(int item) const;
+
+        /**
+         * Split a token of the form word/tag at its last slash.
+         */
+        static void splitToken(std::string const &token, std::string *word,
+            std::string *tag);
+
+    private:
+        // The items of a token, in the parsable and unparsable corpora.
+        struct TokenItems
+        {
+            TaggedItem goodWord;
+            TaggedItem goodTag;
+            TaggedItem badWord;
+            TaggedItem badTag;
+        };
+
+        // An n-gram with its items in both corpora and its frequencies.
+        struct Candidate
+        {
+            MixedNgram good;
+            MixedNgram bad;
+            Tokens ngram;
+            size_t goodFreq;
+            size_t badFreq;
+        };
+
+        // Try to expand an n-gram with an item.
+        bool expand(Candidate *candidate, TaggedItem const &goodItem,
+            TaggedItem const &badItem);
+
+        // Look up the frequencies of an n-gram.
+        void lookup(Candidate *candidate);
+
+        // Return the items of a token from the unparsable hash automaton.
+        TokenItems tokenItems(int token);
+
+        TaggedCorpusIndexPtr d_goodIndex;
+        TaggedCorpusIndexPtr d_badIndex;
+        size_t d_n;
+        double d_expansionFactorAlpha;
+        QHash<int, TokenItems> d_tokenItems;
+    };
+
+}
+
+#endif // ERRORMINING_TAGEXPANDER_HH
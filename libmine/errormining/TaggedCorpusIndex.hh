@@ -0,0 +1,148 @@
+#ifndef ERRORMINING_TAGGEDCORPUSINDEX_HH
+#define ERRORMINING_TAGGEDCORPUSINDEX_HH
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <QSharedPointer>
+
+#include "SuffixArray.hh"
+
+namespace errormining
+{
+
+/**
+ * An item of a mixed n-gram: a word or a part-of-speech tag, represented
+ * by its identifier in a TaggedCorpusIndex.
+ */
+struct TaggedItem
+{
+	enum Type { WORD, TAG };
+
+	TaggedItem() : type(WORD), id(-1) {}
+	TaggedItem(Type newType, int newId) : type(newType), id(newId) {}
+
+	Type type;
+	int id;
+};
+
+typedef std::vector<TaggedItem> MixedNgram;
+
+/**
+ * An index over a corpus of tagged sentences, that gives the frequencies
+ * of n-grams in which every item is either a word or a tag.
+ *
+ * The words and tags of the corpus are stored as two parallel streams,
+ * each with its own suffix array. To find a mixed n-gram, each maximal
+ * run of words or tags in the n-gram is looked up in the suffix array
+ * of its stream. The occurrences of the rarest run are then refined by
+ * checking the remaining items of the n-gram in the parallel streams.
+ * The cost of a lookup is therefore bounded by the frequency of the
+ * rarest run, rather than by the length of the n-gram.
+ *
+ * Sentences are separated by an end marker in both streams, so n-grams
+ * never span sentences.
+ */
+class TaggedCorpusIndex
+{
+public:
+	TaggedCorpusIndex();
+
+	/**
+	 * Add a sentence, with one tag per word. Sentences can only be added
+	 * before the index is built.
+	 */
+	void addSentence(std::vector<std::string> const &words,
+		std::vector<std::string> const &tags);
+
+	/**
+	 * Return the frequency of a mixed n-gram. Items with an identifier
+	 * of -1 (unknown words or tags) never occur.
+	 */
+	size_t freq(MixedNgram const &ngram) const;
+
+	/**
+	 * Build the suffix arrays of the word and tag streams.
+	 */
+	void index(SuffixArray<int>::SortAlgorithm sortAlgorithm =
+		SuffixArray<int>::SSORT);
+
+	/**
+	 * Return the number of sentences in the corpus.
+	 */
+	size_t nSentences() const;
+
+	/**
+	 * Return the tag with the given identifier.
+	 */
+	std::string const &tag(int id) const;
+
+	/**
+	 * Return the identifier of a tag, or -1 if the tag does not occur
+	 * in the corpus.
+	 */
+	int tagId(std::string const &tag) const;
+
+	/**
+	 * Return the word with the given identifier.
+	 */
+	std::string const &word(int id) const;
+
+	/**
+	 * Return the identifier of a word, or -1 if the word does not occur
+	 * in the corpus.
+	 */
+	int wordId(std::string const &word) const;
+private:
+	TaggedCorpusIndex(TaggedCorpusIndex const &other);
+	TaggedCorpusIndex &operator=(TaggedCorpusIndex const &other);
+
+	typedef std::map<std::string, int> Vocabulary;
+	typedef QSharedPointer<SuffixArray<int> const> SuffixArrayPtr;
+
+	static int addToVocabulary(Vocabulary *vocabulary,
+		std::vector<std::string> *items, std::string const &item);
+	static std::string const &item(std::vector<std::string> const &items,
+		int id);
+	static int lookup(Vocabulary const &vocabulary, std::string const &item);
+
+	Vocabulary d_words;
+	Vocabulary d_tags;
+	std::vector<std::string> d_wordList;
+	std::vector<std::string> d_tagList;
+	QSharedPointer<std::vector<int> > d_wordStream;
+	QSharedPointer<std::vector<int> > d_tagStream;
+	SuffixArrayPtr d_wordSuffixArray;
+	SuffixArrayPtr d_tagSuffixArray;
+	size_t d_nSentences;
+};
+
+inline size_t TaggedCorpusIndex::nSentences() const
+{
+	return d_nSentences;
+}
+
+inline std::string const &TaggedCorpusIndex::tag(int id) const
+{
+	return item(d_tagList, id);
+}
+
+inline int TaggedCorpusIndex::tagId(std::string const &tag) const
+{
+	return lookup(d_tags, tag);
+}
+
+inline std::string const &TaggedCorpusIndex::word(int id) const
+{
+	return item(d_wordList, id);
+}
+
+inline int TaggedCorpusIndex::wordId(std::string const &word) const
+{
+	return lookup(d_words, word);
+}
+
+}
+
+#endif // ERRORMINING_TAGGEDCORPUSINDEX_HH
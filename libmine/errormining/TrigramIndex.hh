@@ -0,0 +1,85 @@
+#ifndef ERRORMINING_TRIGRAMINDEX_HH
+#define ERRORMINING_TRIGRAMINDEX_HH
+
+#include <string>
+#include <vector>
+
+#include <QHash>
+#include <QtGlobal>
+
+namespace errormining
+{
+
+/**
+ * An inverted index from byte trigrams to the sentences in which they
+ * occur. Sentences are indexed on the trigrams of their UTF-8 text, a
+ * trigram is packed in an integer as (b0 << 16) | (b1 << 8) | b2.
+ *
+ * The sentences in which a trigram occurs are stored as a posting list:
+ * the ascending sentence identifiers, encoded as the differences between
+ * successive identifiers in a variable-length format with seven bits
+ * per byte. The least significant group comes first, the high bit of a
+ * byte is set when more bytes follow.
+ *
+ * Since every sentence that contains a string contains all trigrams of
+ * that string, intersecting the posting lists of those trigrams gives
+ * a small superset of the sentences that contain the string.
+ */
+class TrigramIndex
+{
+public:
+	typedef std::vector<quint32> Postings;
+	typedef QHash<quint32, std::string> EncodedPostings;
+
+	/**
+	 * Add the trigrams of a sentence to the index. Sentences must be
+	 * added in ascending order of their identifiers.
+	 */
+	void add(quint32 sentenceId, char const *text, size_t len);
+
+	/**
+	 * Return the encoded posting list of every trigram.
+	 */
+	EncodedPostings const &encodedPostings() const;
+
+	/**
+	 * Decode an encoded posting list, the identifiers are appended to
+	 * postings.
+	 */
+	static void decode(char const *data, size_t len, Postings *postings);
+
+	/**
+	 * Intersect two ascending posting lists.
+	 */
+	static Postings intersect(Postings const &postings1,
+		Postings const &postings2);
+
+	/**
+	 * Return the literal strings that every match of a regular expression
+	 * in the QRegExp syntax must contain. Only literals of at least three
+	 * bytes are returned. The extraction is conservative: if no literal
+	 * is returned, the index cannot be used to find matches.
+	 *
+	 * @param pattern The regular expression, in UTF-8.
+	 */
+	static std::vector<std::string> regExpLiterals(std::string const &pattern);
+
+	/**
+	 * Return the distinct trigrams of a text, in ascending order.
+	 */
+	static std::vector<quint32> trigrams(char const *text, size_t len);
+private:
+	EncodedPostings d_postings;
+
+	// The last sentence added to the posting list of each trigram.
+	QHash<quint32, quint32> d_lastIds;
+};
+
+inline TrigramIndex::EncodedPostings const &TrigramIndex::encodedPostings() const
+{
+	return d_postings;
+}
+
+}
+
+#endif // ERRORMINING_TRIGRAMINDEX_HH
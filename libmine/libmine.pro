@@ -5,26 +5,48 @@ QT = core
 QMAKE_CXXFLAGS += -O2 -Wall -Wextra -I. -DFLEXIBLE -DNUMBERS -DSTOPBIT \
 	-DNEXTBIT -DMORPH_INFIX -DPOOR_MORPH -DLOOSING_RPM -DMULTICOLUMN
 
-SOURCES=fadd/fadd.cpp src/Form/Form.cpp \
+float_suspicion {
+	DEFINES += ERRORMINING_FLOAT_SUSPICION
+}
+
+SOURCES=fadd/fadd.cpp src/BestRatioExpander.cpp \
+	src/DynamicSuffixArray/DynamicSuffixArray.cpp src/Expander.cpp \
+	src/Form/Form.cpp src/FormSentenceIncidence/FormSentenceIncidence.cpp \
 	src/HashAutomaton/HashAutomaton.cpp src/HashedCorpus/HashedCorpus.cpp \
-	src/Miner/Miner.cpp src/Observable/Observable.cpp \
+	src/Miner/Miner.cpp src/Miner/checkpoint.cpp \
+	src/MiningResults/MiningResults.cpp \
+	src/Observable/Observable.cpp src/RankingEvaluator/RankingEvaluator.cpp \
 	src/ScoringMethod/ScoringMethod.cpp \
-	src/Sentence/Sentence.cpp src/SuffixArray/SuffixArray.cpp \
+	src/Sentence/Sentence.cpp src/SimpleExpander.cpp \
+	src/SuffixArray/SuffixArray.cpp src/TagExpander.cpp \
+	src/TaggedCorpusIndex/TaggedCorpusIndex.cpp \
 	src/TokenizedSentenceReader/TokenizedSentenceReader.cpp \
-	src/util/ssort/ssort.cpp
+	src/TrigramIndex/TrigramIndex.cpp src/util/ssort/ssort.cpp
 
-HEADERS=errormining/HashedCorpus.hh errormining/SentenceHandler.hh \
+HEADERS=errormining/BestRatioExpander.hh errormining/DynamicSuffixArray.hh \
+	errormining/Expander.hh \
+	errormining/HashedCorpus.hh errormining/SentenceHandler.hh \
 	errormining/SuffixArray.hh errormining/HashAutomaton.hh \
-	errormining/Form.hh errormining/Miner.hh errormining/Observer.hh \
-	errormining/ScoringMethod.hh errormining/Sentence.hh \
-	errormining/TokenizedSentenceReader.hh errormining/util/ssort.hh \
+	errormining/Form.hh errormining/Miner.hh errormining/MiningResults.hh \
+	errormining/FormSentenceIncidence.hh errormining/Observer.hh \
+	errormining/RankingEvaluator.hh errormining/ScoringMethod.hh \
+	errormining/Sentence.hh errormining/SimpleExpander.hh \
+	errormining/TagExpander.hh \
+	errormining/TaggedCorpusIndex.hh \
+	errormining/TokenizedSentenceReader.hh errormining/TrigramIndex.hh \
+	errormining/util/ssort.hh \
 	errormining/Observable.hh
 
 # Internal headers
 HEADERS+=src/Observable/Observable.ih src/HashedCorpus/HashedCorpus.ih \
+	src/DynamicSuffixArray/DynamicSuffixArray.ih \
 	src/TokenizedSentenceReader/TokenizedSentenceReader.ih \
 	src/ScoringMethod/ScoringMethod.ih src/Sentence/Sentence.ih \
 	src/HashAutomaton/HashAutomaton.ih src/SuffixArray/SuffixArray.ih \
-	src/Miner/Miner.ih src/Form/Form.ih src/util/ssort/ssort.ih
+	src/Miner/Miner.ih src/MiningResults/MiningResults.ih src/Form/Form.ih \
+	src/FormSentenceIncidence/FormSentenceIncidence.ih \
+	src/RankingEvaluator/RankingEvaluator.ih \
+	src/TaggedCorpusIndex/TaggedCorpusIndex.ih \
+	src/TrigramIndex/TrigramIndex.ih src/util/ssort/ssort.ih
 
 mac:CONFIG -= app_bundle
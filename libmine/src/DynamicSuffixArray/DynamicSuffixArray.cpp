@@ -0,0 +1,159 @@
+#include "DynamicSuffixArray.ih"
+
+namespace {
+
+// Replace every value by its rank among the distinct values of the
+// data. This gives dense codes 0..k-1 in the same order.
+vector<int> *denseCodes(vector<int> const &data)
+{
+	vector<int> values(data);
+	sort(values.begin(), values.end());
+	values.erase(unique(values.begin(), values.end()), values.end());
+
+	vector<int> *codes = new vector<int>;
+	codes->reserve(data.size());
+	for (vector<int>::const_iterator iter = data.begin();
+			iter != data.end(); ++iter)
+		codes->push_back(lower_bound(values.begin(), values.end(), *iter) -
+			values.begin());
+
+	return codes;
+}
+
+}
+
+DynamicSuffixArray::DynamicSuffixArray(SegmentPtr base) : d_merging(false)
+{
+	d_segments.push_back(base);
+}
+
+DynamicSuffixArray::~DynamicSuffixArray()
+{
+	waitForMerges();
+}
+
+void DynamicSuffixArray::add(SegmentPtr delta)
+{
+	if (delta->data().empty())
+		return;
+
+	{
+		QWriteLocker locker(&d_segmentsLock);
+		d_segments.push_back(delta);
+	}
+
+	QMutexLocker locker(&d_mergeMutex);
+	scheduleMerge();
+}
+
+size_t DynamicSuffixArray::frequency(vector<int>::const_iterator begin,
+	vector<int>::const_iterator end) const
+{
+	QReadLocker locker(&d_segmentsLock);
+
+	size_t freq = 0;
+	for (QList<SegmentPtr>::const_iterator iter = d_segments.begin();
+			iter != d_segments.end(); ++iter)
+	{
+		SuffixArray<int>::IterPair matches = (*iter)->find(begin, end);
+		freq += distance(matches.first, matches.second);
+	}
+
+	return freq;
+}
+
+size_t DynamicSuffixArray::nSegments() const
+{
+	QReadLocker locker(&d_segmentsLock);
+	return d_segments.size();
+}
+
+void DynamicSuffixArray::scheduleMerge()
+{
+	if (d_merging)
+		return;
+
+	QList<SegmentPtr> segments;
+	{
+		QReadLocker locker(&d_segmentsLock);
+		segments = d_segments;
+	}
+
+	// Extend the range of segments to merge backwards, for as long as the
+	// preceding segment is not larger than the range. The base segment is
+	// never merged, since that would copy and sort the whole corpus.
+	int first = segments.size() - 1;
+	size_t rangeSize = segments.last()->data().size();
+	while (first > 1 && segments[first - 1]->data().size() <= rangeSize)
+	{
+		--first;
+		rangeSize += segments[first]->data().size();
+	}
+
+	if (first == segments.size() - 1)
+		return;
+
+	d_merging = true;
+	d_merge = QtConcurrent::run(merge, this, first,
+		segments.mid(first));
+}
+
+void DynamicSuffixArray::merge(DynamicSuffixArray *suffixArray, int first,
+	QList<SegmentPtr> segments)
+{
+	// Concatenate the data of the segments, separated by a delimiter that
+	// is not a hash code.
+	QSharedPointer<vector<int> > data(new vector<int>);
+	for (QList<SegmentPtr>::const_iterator iter = segments.begin();
+			iter != segments.end(); ++iter)
+	{
+		if (iter != segments.begin())
+			data->push_back(numeric_limits<int>::min());
+		data->insert(data->end(), (*iter)->data().begin(),
+			(*iter)->data().end());
+	}
+
+	// McIlroy and McIlroy's algorithm requires dense codes, which the
+	// identifiers of a few segments and the delimiter are not. Sort the
+	// suffixes of the dense codes of the data instead, they have the
+	// same order.
+	SuffixArray<int> codeSuffixes(QSharedPointer<vector<int> const>(
+		denseCodes(*data)), SuffixArray<int>::SSORT);
+	SegmentPtr merged(new SuffixArray<int>(*data,
+		codeSuffixes.suffixArray()));
+
+	// Segments are only appended while we were merging, so the merged
+	// segments are still at the same position.
+	{
+		QWriteLocker locker(&suffixArray->d_segmentsLock);
+		for (int i = 0; i < segments.size(); ++i)
+			suffixArray->d_segments.removeAt(first);
+		suffixArray->d_segments.insert(first, merged);
+	}
+
+	// Segments that were added during the merge may have to be merged as
+	// well.
+	QMutexLocker locker(&suffixArray->d_mergeMutex);
+	suffixArray->d_merging = false;
+	suffixArray->scheduleMerge();
+}
+
+void DynamicSuffixArray::waitForMerges()
+{
+	for (;;)
+	{
+		QFuture<void> merge;
+		bool merging;
+		{
+			QMutexLocker locker(&d_mergeMutex);
+			merging = d_merging;
+			merge = d_merge;
+		}
+
+		// Also wait for the last merge if it has cleared the merging flag,
+		// since it may still be using the mutex.
+		merge.waitForFinished();
+		if (!merging)
+			return;
+	}
+}
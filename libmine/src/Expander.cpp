@@ -1,6 +1,7 @@
 #include <utility>
 #include <vector>
 
+#include <errormining/DynamicSuffixArray.hh>
 #include <errormining/Expander.hh>
 #include <errormining/HashAutomaton.hh>
 #include <errormining/SuffixArray.hh>
@@ -26,13 +27,24 @@ namespace errormining {
         Tokens parsableNgram = unparsableToParsableHashCodes(ngramBegin,
                                                              ngramEnd);
         
-        SuffixArray<int>::IterPair goodIters = d_goodSuffixArray->find(parsableNgram.begin(),
-                                                                       parsableNgram.end());
-        size_t goodFreq = distance(goodIters.first, goodIters.second);
-        
-        SuffixArray<int>::IterPair badIters = d_badSuffixArray->find(ngramBegin,
-                                                                     ngramEnd);
-        size_t badFreq = distance(badIters.first, badIters.second);
+        size_t goodFreq;
+        size_t badFreq;
+        if (d_goodDynamicSuffixArray.isNull())
+        {
+            SuffixArray<int>::IterPair goodIters = d_goodSuffixArray->find(parsableNgram.begin(),
+                                                                           parsableNgram.end());
+            goodFreq = distance(goodIters.first, goodIters.second);
+            
+            SuffixArray<int>::IterPair badIters = d_badSuffixArray->find(ngramBegin,
+                                                                         ngramEnd);
+            badFreq = distance(badIters.first, badIters.second);
+        }
+        else
+        {
+            goodFreq = d_goodDynamicSuffixArray->frequency(parsableNgram.begin(),
+                                                           parsableNgram.end());
+            badFreq = d_badDynamicSuffixArray->frequency(ngramBegin, ngramEnd);
+        }
         
         // Cache if this was a unigram.
         if (distance(ngramBegin, ngramEnd) == 1)
@@ -42,6 +54,11 @@ namespace errormining {
         return std::make_pair(goodFreq, badFreq);
     }
     
+    void Expander::clearCache()
+    {
+        d_freqCache->clear();
+    }
+    
     std::vector<int> Expander::unparsableToParsableHashCodes(
         TokensIter const &unparsableNgramBegin,
         TokensIter const &unparsableNgramEnd) const
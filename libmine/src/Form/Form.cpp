@@ -21,6 +21,7 @@ void Form::copy(Form const &other)
 {
 	d_ngram = QSharedPointer<vector<int> >(new vector<int>(*other.d_ngram));
 	d_suspicion = other.d_suspicion;
+	d_cycleSuspicion = other.d_cycleSuspicion;
 	d_unsuspObservations = other.d_unsuspObservations;
 	d_suspObservations = other.d_suspObservations;
 }
@@ -0,0 +1,33 @@
+#include "FormSentenceIncidence.ih"
+
+FormSentenceIncidence::FormSentenceIncidence(vector<Link> const &links,
+		vector<bool> const &unparsable) :
+	d_unparsable(unparsable), d_nUnparsable(0)
+{
+	size_t nForms = 0;
+	size_t nSentences = d_unparsable.size();
+	for (vector<Link>::const_iterator iter = links.begin();
+			iter != links.end(); ++iter)
+	{
+		nForms = max<size_t>(nForms, iter->first + 1);
+		nSentences = max<size_t>(nSentences, iter->second + 1);
+	}
+
+	// Sentences that were not given are parsable.
+	d_unparsable.resize(nSentences, false);
+	d_nUnparsable = count(d_unparsable.begin(), d_unparsable.end(), true);
+
+	// Counting sort of the links by form.
+	d_offsets.assign(nForms + 1, 0);
+	for (vector<Link>::const_iterator iter = links.begin();
+			iter != links.end(); ++iter)
+		++d_offsets[iter->first + 1];
+	for (size_t i = 1; i < d_offsets.size(); ++i)
+		d_offsets[i] += d_offsets[i - 1];
+
+	d_sentences.resize(links.size());
+	vector<quint32> next(d_offsets.begin(), d_offsets.end() - 1);
+	for (vector<Link>::const_iterator iter = links.begin();
+			iter != links.end(); ++iter)
+		d_sentences[next[iter->first]++] = iter->second;
+}
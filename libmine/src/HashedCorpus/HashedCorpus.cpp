@@ -6,9 +6,14 @@ void HashedCorpus::handleSentence(vector<string> const &tokens,
 	// Select the corpus and automaton based on the error rate of the
 	// sentence (0.0 is parsable).
 	vector<int> *corpus = error == 0.0 ? d_goodCorpus.data() : d_badCorpus.data();
+	vector<size_t> *sentenceStarts = error == 0.0 ?
+			d_goodSentenceStarts.data() : d_badSentenceStarts.data();
 	HashAutomaton const *hashAutomaton = error == 0.0 ?
 			d_parsableHashAutomaton.data() : d_unparsableHashAutomaton.data();
 
+	// Sentences are concatenated, so remember where this one starts.
+	sentenceStarts->push_back(corpus->size());
+
 	// Hash the sentence.
 	transform(tokens.begin(), tokens.end(), back_inserter(*corpus),
 			*hashAutomaton);
@@ -7,6 +7,13 @@ bool FormProbComp::operator()(Form const &lhs, Form const &rhs) const
 	return lhs.suspicion() > rhs.suspicion();
 }
 
+bool FormPtrProbComp::operator()(Form const *lhs, Form const *rhs) const
+{
+	if (lhs->suspicion() == rhs->suspicion())
+		return *lhs < *rhs;
+	return lhs->suspicion() > rhs->suspicion();
+}
+
 uint errormining::qHash(FormPtr const &formPtr)
 {
 	size_t seed = *formPtr.value->ngram().begin();
@@ -20,6 +27,42 @@ uint errormining::qHash(FormPtr const &formPtr)
 	return seed;
 }
 
+Miner::Miner(Miner const &other) :
+	SentenceHandler(), Observable(),
+	d_parsableHashAutomaton(other.d_parsableHashAutomaton),
+	d_unparsableHashAutomaton(other.d_unparsableHashAutomaton),
+	d_expander(other.d_expander),
+	d_smoothing(other.d_smoothing), d_smoothingBeta(other.d_smoothingBeta),
+	d_checkpointInterval(0),
+	d_forms(new QSet<FormPtr>()),
+	d_sentences(new list<Sentence>()),
+	d_ratioCache(new QCache<QVector<int>, double>(1000000))
+{
+	// Copy the forms, and remember the copy of each form, so that the
+	// observations in sentences can be redirected to the copies.
+	QHash<Form const *, Form *> copies;
+	copies.reserve(other.d_forms->size());
+	d_forms->reserve(other.d_forms->size());
+	for (FormPtrSet::const_iterator formIter = other.d_forms->begin();
+			formIter != other.d_forms->end(); ++formIter)
+	{
+		Form *form = new Form(*formIter->value);
+		copies.insert(formIter->value, form);
+		d_forms->insert(FormPtr(form));
+	}
+
+	for (list<Sentence>::const_iterator sentenceIter = other.d_sentences->begin();
+			sentenceIter != other.d_sentences->end(); ++sentenceIter)
+	{
+		Sentence sentence(sentenceIter->error());
+		for (Sentence::const_iterator formIter = sentenceIter->begin();
+				formIter != sentenceIter->end(); ++formIter)
+			sentence.addObservedForm(copies.value(*formIter));
+
+		d_sentences->push_back(sentence);
+	}
+}
+
 void Miner::destroy()
 {
 	for (FormPtrSet::const_iterator formIter = d_forms->begin();
@@ -27,9 +70,18 @@ void Miner::destroy()
 		delete formIter->value;
 }
 
+void Miner::clearCycleSuspicions()
+{
+	for (FormPtrSet::const_iterator iter = d_forms->begin();
+			iter != d_forms->end(); ++iter)
+		iter->value->setCycleSuspicion(0.0);
+}
+
 void Miner::calculateInitialFormSuspicions(double suspThreshold)
 {
-	QHash<Form *, double> formSuspSums;
+	// The suspicions of observations are summed in the cycle suspicions
+	// of the forms.
+	clearCycleSuspicions();
 
 	// Calculate the initial observation suspicions.
 	for (list<Sentence>::const_iterator sentenceIter = d_sentences->begin();
@@ -42,20 +94,20 @@ void Miner::calculateInitialFormSuspicions(double suspThreshold)
 			// the observations within a sentence.
 			double suspicion = sentenceIter->error() /
 				sentenceIter->observedForms().size();
-			formSuspSums[const_cast<Form *>(*formIter)] += suspicion;
+			const_cast<Form *>(*formIter)->addCycleSuspicion(suspicion);
 		}
 	}
 
 	// Calculate the initial form suspicions.
-	for (QHash<Form *, double>::const_iterator formIter =
-		formSuspSums.begin(); formIter != formSuspSums.end(); ++formIter)
+	for (FormPtrSet::const_iterator formIter = d_forms->begin();
+			formIter != d_forms->end(); ++formIter)
 	{
 		// The suspicion of a form is the average of all suspicions of
 		// observations of the form. Since all observations within parsable
 		// sentences have a suspicion of 0.0, they don't add to the sum,
 		// only the total number of observations.
-		double suspicion = formIter.value() / formIter.key()->nObservations();
-		formIter.key()->setSuspicion(suspicion);
+		Form *form = formIter->value;
+		form->setSuspicion(form->cycleSuspicion() / form->nObservations());
 	}
 
 	// Form suspicion smoothing.
@@ -86,8 +138,10 @@ void Miner::calculateInitialFormSuspicions(double suspThreshold)
 
 double Miner::calculateFormSuspicions(double suspThreshold)
 {
-	QHash<Form *, double> formSuspSums;
-	QHash<Form *, double> oldSusps;
+	// The suspicions of observations are summed in the cycle suspicions
+	// of the forms, rather than in hash tables, so that a cycle only
+	// streams over the forms and sentences.
+	clearCycleSuspicions();
 
 	// Calculate suspicions of observations of a form within a sentence.
 	for (list<Sentence>::const_iterator sentenceIter = d_sentences->begin();
@@ -107,21 +161,24 @@ double Miner::calculateFormSuspicions(double suspThreshold)
 			// the form with sentence-level normalization.
 			double suspicion = sentenceIter->error() *
 				((*formIter)->suspicion() / sentenceSuspSum);
-			formSuspSums[const_cast<Form *>(*formIter)] += suspicion;
+			const_cast<Form *>(*formIter)->addCycleSuspicion(suspicion);
 		}
 	}
 
-	for (QHash<Form *, double>::const_iterator formIter =
-		formSuspSums.begin(); formIter != formSuspSums.end(); ++formIter)
+	for (FormPtrSet::const_iterator formIter = d_forms->begin();
+			formIter != d_forms->end(); ++formIter)
 	{
 		// The suspicion of a form is the average of all suspicions of
 		// observations of the form. Since all observations within parsable
 		// sentences have a suspicion of 0.0, they don't add to the sum,
 		// only the total number of observations.
-		double suspicion = formIter.value() / formIter.key()->nObservations();
+		Form *form = formIter->value;
+		double suspicion = form->cycleSuspicion() / form->nObservations();
 
-		oldSusps[formIter.key()] = formIter.key()->suspicion();
-		formIter.key()->setSuspicion(suspicion);
+		// The sum is not needed anymore, keep the old suspicion in its
+		// place, to compute the change in suspicion after smoothing.
+		form->setCycleSuspicion(form->suspicion());
+		form->setSuspicion(suspicion);
 	}
 
 	// Form suspicion smoothing.
@@ -146,10 +203,11 @@ double Miner::calculateFormSuspicions(double suspThreshold)
 	// the highest delta that we have seen. The caller can use the highest
 	// delta of a learning cycle to determine when to stop mining.
 	double maxDelta = 0.0;
-	for (QHash<Form *, double>::const_iterator iter = oldSusps.begin();
-			iter != oldSusps.end(); ++iter)
+	for (FormPtrSet::const_iterator iter = d_forms->begin();
+			iter != d_forms->end(); ++iter)
 	{
-		double delta = abs(iter.value() - iter.key()->suspicion());
+		double delta = abs(iter->value->cycleSuspicion() -
+			iter->value->suspicion());
 		if (delta > maxDelta)
 			maxDelta = delta;
 	}
@@ -164,6 +222,15 @@ double Miner::calculateFormSuspicions(double suspThreshold)
 	return maxDelta;
 }
 
+Form const *Miner::form(vector<int> const &ngram) const
+{
+	Form form(ngram);
+	FormPtrSet::const_iterator iter = d_forms->find(FormPtr(&form));
+	if (iter == d_forms->end())
+		return 0;
+	return iter->value;
+}
+
 set<Form, FormProbComp> Miner::forms() const
 {
 	set<Form, FormProbComp> forms;
@@ -176,6 +243,30 @@ set<Form, FormProbComp> Miner::forms() const
 	return forms;
 }
 
+vector<Form const *> Miner::suspiciousForms(size_t minFreq,
+	size_t minSuspFreq, size_t topK) const
+{
+	// Filter first, so that we only order the forms that are of interest.
+	vector<Form const *> forms;
+	for (FormPtrSet::const_iterator formIter = d_forms->begin();
+			formIter != d_forms->end(); ++formIter)
+		if (formIter->value->nObservations() >= minFreq &&
+				formIter->value->nSuspObservations() >= minSuspFreq)
+			forms.push_back(formIter->value);
+
+	// Only the top k forms have to be ordered.
+	if (topK != 0 && topK < forms.size())
+	{
+		partial_sort(forms.begin(), forms.begin() + topK, forms.end(),
+			FormPtrProbComp());
+		forms.resize(topK);
+	}
+	else
+		sort(forms.begin(), forms.end(), FormPtrProbComp());
+
+	return forms;
+}
+
 void Miner::handleSentence(vector<string> const &tokens, double error)
 {
 	// The prescanner can give the necessary frequency information for
@@ -202,19 +293,48 @@ void Miner::handleSentence(vector<string> const &tokens, double error)
     d_sentences->push_back(sentence);
 }
 
+void Miner::cycle(double threshold, double suspThreshold)
+{
+	size_t cycles = 0;
+	while (calculateFormSuspicions(suspThreshold) > threshold)
+	{
+		++cycles;
+		if (d_checkpointInterval != 0 && cycles % d_checkpointInterval == 0)
+			writeCheckpoint(d_checkpointFilename);
+
+		notify();
+	}
+
+	// Also checkpoint the fixed point, runs that converge within the
+	// checkpoint interval can then be resumed as well.
+	if (d_checkpointInterval != 0)
+		writeCheckpoint(d_checkpointFilename);
+
+	notify();
+}
+
 void Miner::mine(double threshold, double suspThreshold)
 {
+	// All forms are new to this mining run.
+	d_newForms.clear();
+
 	// Initial form suspicion calculation.
 	calculateInitialFormSuspicions(suspThreshold);
 
+	// Expansion is usually the most expensive part of a run, checkpoint
+	// its result before cycling starts.
+	if (d_checkpointInterval != 0)
+		writeCheckpoint(d_checkpointFilename);
+
 	// Cycle until the fixed-point is reached.
-	while (calculateFormSuspicions(suspThreshold) > threshold) { notify(); }
-	notify();
+	cycle(threshold, suspThreshold);
 }
 
 void Miner::newSuspForm(Expansion const &expansion, Sentence *sentence)
 {
-	Tokens bestNgramVec(expansion.iters.first, expansion.iters.second);
+	Tokens bestNgramVec(expansion.ngram);
+	if (bestNgramVec.empty())
+		bestNgramVec.assign(expansion.iters.first, expansion.iters.second);
 
 	Form form(bestNgramVec);
 	FormPtr formPtr(&form);
@@ -225,6 +345,7 @@ void Miner::newSuspForm(Expansion const &expansion, Sentence *sentence)
 	if (formIter == d_forms->end()) {
 		formPtr.value = new Form(bestNgramVec, 0.0, expansion.parsableFreq);
 		d_forms->insert(formPtr);
+		d_newForms.push_back(formPtr.value);
 		formIter = d_forms->find(formPtr);
 	}
     
@@ -234,6 +355,131 @@ void Miner::newSuspForm(Expansion const &expansion, Sentence *sentence)
 	formIter->value->newSuspObservation();
 }
 
+void Miner::update(double threshold, double suspThreshold)
+{
+	calculateNewFormSuspicions();
+
+	// Cycle from the current suspicions.
+	cycle(threshold, suspThreshold);
+}
+
+void Miner::calculateNewFormSuspicions()
+{
+	QSet<Form const *> newForms;
+	newForms.reserve(d_newForms.size());
+	for (vector<Form *>::const_iterator iter = d_newForms.begin();
+			iter != d_newForms.end(); ++iter)
+		newForms.insert(*iter);
+	d_newForms.clear();
+
+	if (newForms.isEmpty())
+		return;
+
+	// New forms only occur in new sentences, but we do not keep track of
+	// those, so all sentences are scanned.
+	QHash<Form *, double> formSuspSums;
+	for (list<Sentence>::const_iterator sentenceIter = d_sentences->begin();
+		sentenceIter != d_sentences->end(); ++sentenceIter)
+		for (Sentence::const_iterator formIter = sentenceIter->begin();
+			formIter != sentenceIter->end(); ++formIter)
+			if (newForms.contains(*formIter))
+				formSuspSums[const_cast<Form *>(*formIter)] +=
+					sentenceIter->error() / sentenceIter->observedForms().size();
+
+	for (QHash<Form *, double>::const_iterator formIter =
+		formSuspSums.begin(); formIter != formSuspSums.end(); ++formIter)
+		formIter.key()->setSuspicion(formIter.value() /
+			formIter.key()->nObservations());
+}
+
+void Miner::addParsableSentences(SuffixArray<int> const &batch)
+{
+	if (batch.data().empty())
+		return;
+
+	// Every token is converted to a parsable hash code only once.
+	QHash<int, int> parsableIds;
+
+	vector<int> parsableNgram;
+	for (FormPtrSet::const_iterator formIter = d_forms->begin();
+			formIter != d_forms->end(); ++formIter)
+	{
+		vector<int> const &ngram = formIter->value->ngram();
+
+		parsableNgram.clear();
+		for (vector<int>::const_iterator tokenIter = ngram.begin();
+				tokenIter != ngram.end(); ++tokenIter)
+		{
+			QHash<int, int>::const_iterator idIter = parsableIds.find(*tokenIter);
+			if (idIter == parsableIds.end())
+				idIter = parsableIds.insert(*tokenIter,
+					(*d_parsableHashAutomaton)((*d_unparsableHashAutomaton)(*tokenIter)));
+			parsableNgram.push_back(idIter.value());
+		}
+
+		SuffixArray<int>::IterPair matches = batch.find(parsableNgram.begin(),
+			parsableNgram.end());
+		formIter->value->addUnsuspObservations(
+			distance(matches.first, matches.second));
+	}
+}
+
+void Miner::resume(double threshold, double suspThreshold)
+{
+	// The restored suspicions are the result of a mining cycle, so we
+	// can continue cycling right away.
+	cycle(threshold, suspThreshold);
+}
+
+namespace {
+
+struct FormIn
+{
+	FormIn(QSet<Form const *> const *forms) : d_forms(forms) {}
+	bool operator()(Form const *form) const
+	{
+		return d_forms->contains(form);
+	}
+private:
+	QSet<Form const *> const *d_forms;
+};
+
+}
+
+size_t Miner::removeForms(vector<vector<int> > const &ngrams)
+{
+	QSet<Form const *> forms;
+	for (vector<vector<int> >::const_iterator ngramIter = ngrams.begin();
+			ngramIter != ngrams.end(); ++ngramIter)
+	{
+		Form const *form = this->form(*ngramIter);
+		if (form != 0)
+			forms.insert(form);
+	}
+
+	if (forms.isEmpty())
+		return 0;
+
+	// Remove the observations in one pass over the sentences.
+	for (list<Sentence>::iterator sentenceIter = d_sentences->begin();
+		sentenceIter != d_sentences->end(); ++sentenceIter)
+	{
+		Sentence &sentence = *sentenceIter;
+		sentence.erase(remove_if(sentence.begin(), sentence.end(),
+			FormIn(&forms)), sentence.end());
+	}
+
+	for (QSet<Form const *>::const_iterator iter = forms.begin();
+			iter != forms.end(); ++iter)
+	{
+		Form *form = const_cast<Form *>(*iter);
+		d_forms->remove(FormPtr(form));
+		delete form;
+	}
+
+	return forms.size();
+}
+
 void Miner::removeLowSuspForms(double suspThreshold)
 {
 	// Remove all observations of a form that have a near-zero suspicion.
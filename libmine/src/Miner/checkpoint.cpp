@@ -0,0 +1,154 @@
+#include "Miner.ih"
+
+// Checkpoint layout (native byte order):
+//
+// magic             4 bytes, "EMCP"
+// version           quint32
+// number of forms   quint64
+// per form:         n-gram length (quint32), n-gram (qint32 * length),
+//                   suspicion (double), unsuspicious and suspicious
+//                   observations (quint64 * 2)
+// number of sents   quint64
+// per sentence:     error (double), number of observations (quint32),
+//                   form indices (quint32 * observations)
+
+namespace {
+
+char const CHECKPOINT_MAGIC[] = { 'E', 'M', 'C', 'P' };
+quint32 const CHECKPOINT_VERSION = 1;
+
+template <typename T>
+inline void writeValue(ostream &out, T value)
+{
+	out.write(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
+template <typename T>
+inline T readValue(istream &in)
+{
+	T value;
+	in.read(reinterpret_cast<char *>(&value), sizeof(T));
+	if (!in)
+		throw runtime_error("Truncated checkpoint");
+	return value;
+}
+
+}
+
+void Miner::readCheckpoint(string const &filename)
+{
+	ifstream in(filename.c_str(), ios::binary);
+	if (!in.good())
+		throw runtime_error("Could not read checkpoint " + filename);
+
+	char magic[sizeof(CHECKPOINT_MAGIC)];
+	in.read(magic, sizeof(magic));
+	if (!in || !equal(magic, magic + sizeof(magic), CHECKPOINT_MAGIC) ||
+			readValue<quint32>(in) != CHECKPOINT_VERSION)
+		throw runtime_error(filename + " is not a valid checkpoint");
+
+	destroy();
+	d_forms->clear();
+	d_sentences->clear();
+	d_newForms.clear();
+
+	// Forms are stored in order, the observations in sentences refer
+	// to forms by their index.
+	quint64 nForms = readValue<quint64>(in);
+	vector<Form *> forms;
+	forms.reserve(nForms);
+	for (quint64 i = 0; i < nForms; ++i)
+	{
+		quint32 ngramLength = readValue<quint32>(in);
+		vector<int> ngram;
+		ngram.reserve(ngramLength);
+		for (quint32 j = 0; j < ngramLength; ++j)
+			ngram.push_back(readValue<qint32>(in));
+
+		double suspicion = readValue<double>(in);
+		quint64 unsuspObservations = readValue<quint64>(in);
+		quint64 suspObservations = readValue<quint64>(in);
+
+		Form *form = new Form(ngram, suspicion, unsuspObservations,
+			suspObservations);
+		forms.push_back(form);
+		d_forms->insert(FormPtr(form));
+	}
+
+	quint64 nSentences = readValue<quint64>(in);
+	for (quint64 i = 0; i < nSentences; ++i)
+	{
+		Sentence sentence(readValue<double>(in));
+
+		quint32 nObservations = readValue<quint32>(in);
+		for (quint32 j = 0; j < nObservations; ++j)
+		{
+			quint32 formIndex = readValue<quint32>(in);
+			if (formIndex >= forms.size())
+				throw runtime_error(filename + " refers to an unknown form");
+			sentence.addObservedForm(forms[formIndex]);
+		}
+
+		d_sentences->push_back(sentence);
+	}
+}
+
+void Miner::writeCheckpoint(string const &filename) const
+{
+	string tmpFilename = filename + ".tmp";
+
+	{
+		ofstream out(tmpFilename.c_str(), ios::binary | ios::trunc);
+		if (!out.good())
+			throw runtime_error("Could not write checkpoint " + tmpFilename);
+
+		out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+		writeValue<quint32>(out, CHECKPOINT_VERSION);
+
+		// Write forms, and remember their indices.
+		QHash<Form const *, quint32> formIndices;
+		writeValue<quint64>(out, d_forms->size());
+		for (FormPtrSet::const_iterator iter = d_forms->begin();
+				iter != d_forms->end(); ++iter)
+		{
+			Form const *form = iter->value;
+			formIndices.insert(form, formIndices.size());
+
+			vector<int> const &ngram = form->ngram();
+			writeValue<quint32>(out, ngram.size());
+			for (vector<int>::const_iterator tokenIter = ngram.begin();
+					tokenIter != ngram.end(); ++tokenIter)
+				writeValue<qint32>(out, *tokenIter);
+
+			writeValue<double>(out, form->suspicion());
+			writeValue<quint64>(out, form->nUnsuspObservations());
+			writeValue<quint64>(out, form->nSuspObservations());
+		}
+
+		// Write the flattened sentences.
+		writeValue<quint64>(out, d_sentences->size());
+		for (list<Sentence>::const_iterator sentenceIter = d_sentences->begin();
+				sentenceIter != d_sentences->end(); ++sentenceIter)
+		{
+			writeValue<double>(out, sentenceIter->error());
+			writeValue<quint32>(out, sentenceIter->observedForms().size());
+			for (Sentence::const_iterator formIter = sentenceIter->begin();
+					formIter != sentenceIter->end(); ++formIter)
+			{
+				QHash<Form const *, quint32>::const_iterator indexIter =
+					formIndices.find(*formIter);
+				if (indexIter == formIndices.end())
+					throw runtime_error("Could not write checkpoint " +
+						tmpFilename + ": observation of an unknown form");
+				writeValue<quint32>(out, indexIter.value());
+			}
+		}
+
+		out.flush();
+		if (!out.good())
+			throw runtime_error("Could not write checkpoint " + tmpFilename);
+	}
+
+	if (rename(tmpFilename.c_str(), filename.c_str()) != 0)
+		throw runtime_error("Could not rename checkpoint to " + filename);
+}
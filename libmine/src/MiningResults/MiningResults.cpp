@@ -0,0 +1,229 @@
+#include "MiningResults.ih"
+
+// Binary layout (native byte order):
+//
+// magic              4 bytes, "EMRS"
+// version            quint32
+// vocabulary size    quint32
+// vocabulary         per type: length (quint32), characters
+// number of forms    quint64
+// number of tokens   quint64
+// n-gram offsets     quint64 * (forms + 1), offsets into the token arena
+// token arena        quint32 * tokens, indices into the vocabulary
+// suspicions         double * forms
+// frequencies        quint64 * forms
+// unparsable freqs   quint64 * forms
+
+namespace {
+
+char const RESULTS_MAGIC[] = { 'E', 'M', 'R', 'S' };
+quint32 const RESULTS_VERSION = 1;
+
+template <typename T>
+inline void writeValue(ostream &out, T value)
+{
+	out.write(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
+template <typename T>
+inline void writeColumn(ostream &out, vector<T> const &column)
+{
+	if (!column.empty())
+		out.write(reinterpret_cast<char const *>(&column[0]),
+			column.size() * sizeof(T));
+}
+
+template <typename T>
+inline T readValue(istream &in)
+{
+	T value;
+	in.read(reinterpret_cast<char *>(&value), sizeof(T));
+	if (!in)
+		throw MiningResultsException("Truncated mining results");
+	return value;
+}
+
+template <typename T>
+inline void readColumn(istream &in, vector<T> *column, size_t size)
+{
+	column->resize(size);
+	if (size != 0)
+		in.read(reinterpret_cast<char *>(&(*column)[0]), size * sizeof(T));
+	if (!in)
+		throw MiningResultsException("Truncated mining results");
+}
+
+}
+
+void MiningResults::addForm(vector<int> const &ngram, double suspicion,
+	size_t freq, size_t suspFreq)
+{
+	for (vector<int>::const_iterator iter = ngram.begin();
+			iter != ngram.end(); ++iter)
+	{
+		if (*iter < 0 || static_cast<size_t>(*iter) >= d_vocabulary.size())
+			throw MiningResultsException("Token is not in the vocabulary");
+		d_tokens.push_back(*iter);
+	}
+
+	d_ngramOffsets.push_back(d_tokens.size());
+	d_suspicions.push_back(suspicion);
+	d_freqs.push_back(freq);
+	d_suspFreqs.push_back(suspFreq);
+}
+
+string MiningResults::form(size_t index) const
+{
+	string form;
+
+	for (quint64 i = d_ngramOffsets[index]; i < d_ngramOffsets[index + 1]; ++i)
+	{
+		if (i != d_ngramOffsets[index])
+			form += ' ';
+		form += d_vocabulary[d_tokens[i]];
+	}
+
+	return form;
+}
+
+bool MiningResults::isBinary(string const &filename)
+{
+	ifstream in(filename.c_str(), ios::binary);
+
+	char magic[sizeof(RESULTS_MAGIC)];
+	in.read(magic, sizeof(magic));
+
+	return in && equal(magic, magic + sizeof(magic), RESULTS_MAGIC);
+}
+
+void MiningResults::read(string const &filename)
+{
+	bool binary = isBinary(filename);
+
+	ifstream in(filename.c_str(), binary ? ios::binary : ios::in);
+	if (!in.good())
+		throw MiningResultsException("Could not read " + filename);
+
+	if (binary)
+		readBinary(in);
+	else
+		readText(in);
+}
+
+void MiningResults::readBinary(istream &in)
+{
+	char magic[sizeof(RESULTS_MAGIC)];
+	in.read(magic, sizeof(magic));
+	if (!in || !equal(magic, magic + sizeof(magic), RESULTS_MAGIC) ||
+			readValue<quint32>(in) != RESULTS_VERSION)
+		throw MiningResultsException("Not a mining results file");
+
+	quint32 vocabularySize = readValue<quint32>(in);
+	d_vocabulary.clear();
+	d_vocabulary.reserve(vocabularySize);
+	vector<char> typeBuf;
+	for (quint32 i = 0; i < vocabularySize; ++i)
+	{
+		readColumn(in, &typeBuf, readValue<quint32>(in));
+		d_vocabulary.push_back(typeBuf.empty() ? string() :
+			string(&typeBuf[0], typeBuf.size()));
+	}
+
+	quint64 nForms = readValue<quint64>(in);
+	quint64 nTokens = readValue<quint64>(in);
+	readColumn(in, &d_ngramOffsets, nForms + 1);
+	readColumn(in, &d_tokens, nTokens);
+	readColumn(in, &d_suspicions, nForms);
+	readColumn(in, &d_freqs, nForms);
+	readColumn(in, &d_suspFreqs, nForms);
+
+	// Check the n-gram arena, so that accessors do not need to.
+	if (d_ngramOffsets[0] != 0 || d_ngramOffsets[nForms] != nTokens)
+		throw MiningResultsException("Corrupt n-gram offsets");
+	for (quint64 i = 0; i < nForms; ++i)
+		if (d_ngramOffsets[i] > d_ngramOffsets[i + 1])
+			throw MiningResultsException("Corrupt n-gram offsets");
+	for (vector<quint32>::const_iterator iter = d_tokens.begin();
+			iter != d_tokens.end(); ++iter)
+		if (*iter >= vocabularySize)
+			throw MiningResultsException("Token is not in the vocabulary");
+}
+
+void MiningResults::readText(istream &in)
+{
+	map<string, int> typeIds;
+	for (size_t i = 0; i < d_vocabulary.size(); ++i)
+		typeIds[d_vocabulary[i]] = i;
+
+	string line;
+	while (getline(in, line))
+	{
+		istringstream lineStream(line);
+		vector<string> lineParts((istream_iterator<string>(lineStream)),
+			istream_iterator<string>());
+
+		if (lineParts.size() < 4)
+			throw MiningResultsException("Malformed line in result file: " + line);
+
+		vector<int> ngram;
+		for (vector<string>::const_iterator iter = lineParts.begin();
+				iter != lineParts.end() - 3; ++iter)
+		{
+			map<string, int>::iterator typeIter = typeIds.find(*iter);
+			if (typeIter == typeIds.end())
+			{
+				typeIter = typeIds.insert(make_pair(*iter,
+					static_cast<int>(d_vocabulary.size()))).first;
+				d_vocabulary.push_back(*iter);
+			}
+			ngram.push_back(typeIter->second);
+		}
+
+		istringstream numbers(lineParts[lineParts.size() - 3] + " " +
+			lineParts[lineParts.size() - 2] + " " + lineParts[lineParts.size() - 1]);
+		double suspicion;
+		size_t freq;
+		size_t suspFreq;
+		if (!(numbers >> suspicion >> freq >> suspFreq))
+			throw MiningResultsException("Malformed line in result file: " + line);
+
+		addForm(ngram, suspicion, freq, suspFreq);
+	}
+}
+
+void MiningResults::write(string const &filename) const
+{
+	ofstream out(filename.c_str(), ios::binary | ios::trunc);
+	if (!out.good())
+		throw MiningResultsException("Could not write " + filename);
+
+	out.write(RESULTS_MAGIC, sizeof(RESULTS_MAGIC));
+	writeValue<quint32>(out, RESULTS_VERSION);
+
+	writeValue<quint32>(out, d_vocabulary.size());
+	for (vector<string>::const_iterator iter = d_vocabulary.begin();
+			iter != d_vocabulary.end(); ++iter)
+	{
+		writeValue<quint32>(out, iter->size());
+		out.write(iter->data(), iter->size());
+	}
+
+	writeValue<quint64>(out, size());
+	writeValue<quint64>(out, d_tokens.size());
+	writeColumn(out, d_ngramOffsets);
+	writeColumn(out, d_tokens);
+	writeColumn(out, d_suspicions);
+	writeColumn(out, d_freqs);
+	writeColumn(out, d_suspFreqs);
+
+	out.flush();
+	if (!out.good())
+		throw MiningResultsException("Could not write " + filename);
+}
+
+void MiningResults::writeText(ostream &out) const
+{
+	for (size_t i = 0; i < size(); ++i)
+		out << form(i) << " " << d_suspicions[i] << " " << d_freqs[i] <<
+			" " << d_suspFreqs[i] << "\n";
+}
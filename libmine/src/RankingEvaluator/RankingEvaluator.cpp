@@ -0,0 +1,46 @@
+#include "RankingEvaluator.ih"
+
+RankingEvaluator::RankingEvaluator(FormSentenceIncidence const &incidence,
+		double beta) :
+	d_incidence(&incidence), d_betaSquare(beta * beta),
+	d_found(incidence.nSentences(), false), d_parsableFound(0),
+	d_unparsableFound(0)
+{
+}
+
+EvaluationPoint RankingEvaluator::add(size_t form)
+{
+	// Only sentences that were not covered yet change the counts.
+	quint32 const *end = d_incidence->sentencesEnd(form);
+	for (quint32 const *iter = d_incidence->sentencesBegin(form);
+			iter != end; ++iter)
+	{
+		if (d_found[*iter])
+			continue;
+
+		d_found[*iter] = true;
+		if (d_incidence->unparsable(*iter))
+			++d_unparsableFound;
+		else
+			++d_parsableFound;
+	}
+
+	EvaluationPoint point;
+	point.recall = d_unparsableFound /
+		static_cast<double>(d_incidence->nUnparsable());
+	point.precision = d_unparsableFound /
+		static_cast<double>(d_unparsableFound + d_parsableFound);
+	point.fscore = (2.0 * point.precision * point.recall) /
+		(point.precision + point.recall);
+	point.betaFscore = ((1.0 + d_betaSquare) * point.precision * point.recall) /
+		(d_betaSquare * point.precision + point.recall);
+
+	return point;
+}
+
+void RankingEvaluator::reset()
+{
+	d_found.assign(d_found.size(), false);
+	d_parsableFound = 0;
+	d_unparsableFound = 0;
+}
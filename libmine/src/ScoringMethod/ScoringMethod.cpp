@@ -1,5 +1,55 @@
 #include "ScoringMethod.ih"
 
+ScoringMethodInfo const errormining::SCORING_METHODS[] = {
+	{ SCORING_SUSP, "scoring_susp", "score_susp", "suspicion" },
+	{ SCORING_SUSP_OBS, "scoring_susp_obs", "score_susp_obs",
+		"suspicion * number of observations" },
+	{ SCORING_SUSP_UNIQSENTS, "scoring_susp_uniqsents", "score_susp_uniqsents",
+		"suspicion * unique sentences" },
+	{ SCORING_SUSP_LN_OBS, "scoring_susp_ln_obs", "score_susp_ln_obs",
+		"suspicion * ln(number of observations)" },
+	{ SCORING_SUSP_LN_UNIQSENTS, "scoring_susp_ln_uniqsents",
+		"score_susp_ln_uniqsents", "suspicion * ln(unique sentences)" },
+	{ SCORING_SUSP_DELTA, "scoring_susp_delta", "score_susp_delta",
+		"suspicion * (unparsable - parsable observations)" },
+	{ SCORING_SUSP_LN_DELTA, "scoring_susp_ln_delta", "score_susp_ln_delta",
+		"suspicion * ln(unparsable - parsable observations)" }
+};
+
+size_t const errormining::N_SCORING_METHODS =
+	sizeof(SCORING_METHODS) / sizeof(SCORING_METHODS[0]);
+
+bool errormining::scoringMethodByName(string const &name,
+	ScoringMethod *method)
+{
+	for (size_t i = 0; i < N_SCORING_METHODS; ++i)
+		if (name == SCORING_METHODS[i].name)
+		{
+			*method = SCORING_METHODS[i].method;
+			return true;
+		}
+
+	return false;
+}
+
+string errormining::scoringMethodName(ScoringMethod method)
+{
+	for (size_t i = 0; i < N_SCORING_METHODS; ++i)
+		if (SCORING_METHODS[i].method == method)
+			return SCORING_METHODS[i].name;
+
+	return string();
+}
+
+string errormining::scoringMethodColumn(ScoringMethod method)
+{
+	for (size_t i = 0; i < N_SCORING_METHODS; ++i)
+		if (SCORING_METHODS[i].method == method)
+			return SCORING_METHODS[i].column;
+
+	return string();
+}
+
 QSharedPointer<ScoreFun> errormining::selectScoreFun(ScoringMethod scoringMethod)
 {
 	if (scoringMethod == SCORING_SUSP)
@@ -41,7 +41,9 @@ vector<size_t> const *SuffixArray<int>::genSuffixArray(
 	// will modify it to be the suffix array.
 	errormining::util::ssort(suffixArray.data());
 
-	suffixArray->pop_back();
+	// The suffix that only consists of the delimiter is the smallest
+	// suffix, remove it.
+	suffixArray->erase(suffixArray->begin());
 
 	// ssort works on a vector of ints (amongst others because the algorithm
 	// internally uses the sign bit), while the suffix array class uses a
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <errormining/Expander.hh>
+#include <errormining/TagExpander.hh>
+#include <errormining/TaggedCorpusIndex.hh>
+
+namespace {
+    using errormining::TaggedItem;
+
+    // Items of expanded n-grams are encoded by their identifier in the
+    // index of the unparsable corpus. The lowest bit distinguishes tags
+    // from words.
+    inline int encodeItem(TaggedItem const &item)
+    {
+        return 2 * item.id + (item.type == TaggedItem::TAG ? 1 : 0);
+    }
+
+    inline double suspicionRatio(size_t goodFreq, size_t badFreq)
+    {
+        if (badFreq == 0)
+            return 0.0;
+
+        return static_cast<double>(badFreq) / (goodFreq + badFreq);
+    }
+}
+
+namespace errormining {
+    std::vector<Expansion> TagExpander::operator()(TokensIter begin,
+        TokensIter end)
+    {
+        TokensIter ngramEnd = begin + std::min(d_n,
+            static_cast<size_t>(end - begin));
+
+        // The expansion starts with the words of the n-gram.
+        Candidate best;
+        for (TokensIter iter = begin; iter != ngramEnd; ++iter)
+        {
+            TokenItems items = tokenItems(*iter);
+            best.good.push_back(items.goodWord);
+            best.bad.push_back(items.badWord);
+            best.ngram.push_back(encodeItem(items.badWord));
+        }
+        lookup(&best);
+
+        // Prefer expanding with a tag, since a tag generalizes over the
+        // words that it covers.
+        for (TokensIter iter = ngramEnd; iter != end; ++iter)
+        {
+            TokenItems items = tokenItems(*iter);
+            if (!expand(&best, items.goodTag, items.badTag) &&
+                    !expand(&best, items.goodWord, items.badWord))
+                break;
+        }
+
+        std::vector<Expansion> expansions;
+        expansions.push_back(Expansion(best.ngram, best.goodFreq, best.badFreq));
+        return expansions;
+    }
+
+    bool TagExpander::expand(Candidate *candidate, TaggedItem const &goodItem,
+        TaggedItem const &badItem)
+    {
+        // Get the n+1-gram, which we will call a m-gram.
+        Candidate mgram(*candidate);
+        mgram.good.push_back(goodItem);
+        mgram.bad.push_back(badItem);
+        mgram.ngram.push_back(encodeItem(badItem));
+        lookup(&mgram);
+
+        double mgramRatio = suspicionRatio(mgram.goodFreq, mgram.badFreq);
+
+        double factor = 1.0;
+        if (d_expansionFactorAlpha != 0.0)
+            factor = expansionFactor(mgram.badFreq);
+
+        if (mgramRatio <= factor * suspicionRatio(candidate->goodFreq,
+                candidate->badFreq))
+            return false;
+
+        // Get the second n-gram within the m-gram.
+        Candidate second;
+        second.good.assign(mgram.good.begin() + 1, mgram.good.end());
+        second.bad.assign(mgram.bad.begin() + 1, mgram.bad.end());
+        second.ngram.assign(mgram.ngram.begin() + 1, mgram.ngram.end());
+        lookup(&second);
+
+        if (mgramRatio <= factor * suspicionRatio(second.goodFreq,
+                second.badFreq))
+            return false;
+
+        *candidate = mgram;
+        return true;
+    }
+
+    double TagExpander::expansionFactor(size_t unparsableFreq) const
+    {
+        return 1.0 + exp(-d_expansionFactorAlpha * static_cast<double>(unparsableFreq));
+    }
+
+    std::string const &TagExpander::itemString(int item) const
+    {
+        if (item < 0)
+            throw std::runtime_error("Unknown word or tag identifier");
+
+        if (item % 2 == 1)
+            return d_badIndex->tag(item / 2);
+
+        return d_badIndex->word(item / 2);
+    }
+
+    void TagExpander::lookup(Candidate *candidate)
+    {
+        std::pair<size_t, size_t> *freqs;
+        if ((freqs = freqCache()->object(candidate->ngram)) != 0)
+        {
+            candidate->goodFreq = freqs->first;
+            candidate->badFreq = freqs->second;
+            return;
+        }
+
+        candidate->goodFreq = d_goodIndex->freq(candidate->good);
+        candidate->badFreq = d_badIndex->freq(candidate->bad);
+
+        // Mixed n-grams are cached regardless of their length, since
+        // sequences of tags recur often.
+        freqCache()->insert(candidate->ngram,
+            new std::pair<size_t, size_t>(candidate->goodFreq, candidate->badFreq),
+            candidate->ngram.size());
+    }
+
+    void TagExpander::splitToken(std::string const &token, std::string *word,
+        std::string *tag)
+    {
+        std::string::size_type sep = token.rfind('/');
+        if (sep == std::string::npos)
+            throw std::runtime_error("Token without a tag: " + token);
+
+        *word = token.substr(0, sep);
+        *tag = token.substr(sep + 1);
+    }
+
+    TagExpander::TokenItems TagExpander::tokenItems(int token)
+    {
+        QHash<int, TokenItems>::const_iterator iter =
+            d_tokenItems.constFind(token);
+        if (iter != d_tokenItems.constEnd())
+            return iter.value();
+
+        // Tokens that are not in the hash automaton never occur.
+        TokenItems items;
+        if (token >= 0)
+        {
+            std::string word;
+            std::string tag;
+            splitToken((*unparsableHashAutomaton())(token), &word, &tag);
+
+            items.goodWord = TaggedItem(TaggedItem::WORD, d_goodIndex->wordId(word));
+            items.goodTag = TaggedItem(TaggedItem::TAG, d_goodIndex->tagId(tag));
+            items.badWord = TaggedItem(TaggedItem::WORD, d_badIndex->wordId(word));
+            items.badTag = TaggedItem(TaggedItem::TAG, d_badIndex->tagId(tag));
+        }
+        else
+        {
+            items.goodTag.type = TaggedItem::TAG;
+            items.badTag.type = TaggedItem::TAG;
+        }
+
+        d_tokenItems.insert(token, items);
+        return items;
+    }
+}
@@ -0,0 +1,163 @@
+#include "TaggedCorpusIndex.ih"
+
+namespace {
+
+// Identifier of the end marker of a sentence. Words and tags are
+// numbered from one, so that the streams hold every identifier from zero
+// to the size of the vocabulary, as ssort requires.
+int const SENTENCE_END = 0;
+
+}
+
+TaggedCorpusIndex::TaggedCorpusIndex() :
+	d_wordStream(new vector<int>), d_tagStream(new vector<int>),
+	d_nSentences(0)
+{
+}
+
+void TaggedCorpusIndex::addSentence(vector<string> const &words,
+	vector<string> const &tags)
+{
+	if (!d_wordSuffixArray.isNull())
+		throw runtime_error("Cannot add sentences to a built index");
+	if (words.size() != tags.size())
+		throw runtime_error("Sentence has a different number of words and tags");
+
+	for (size_t i = 0; i < words.size(); ++i)
+	{
+		d_wordStream->push_back(addToVocabulary(&d_words, &d_wordList,
+			words[i]));
+		d_tagStream->push_back(addToVocabulary(&d_tags, &d_tagList, tags[i]));
+	}
+
+	d_wordStream->push_back(SENTENCE_END);
+	d_tagStream->push_back(SENTENCE_END);
+
+	++d_nSentences;
+}
+
+int TaggedCorpusIndex::addToVocabulary(Vocabulary *vocabulary,
+	vector<string> *items, string const &item)
+{
+	Vocabulary::iterator iter = vocabulary->lower_bound(item);
+	if (iter != vocabulary->end() && iter->first == item)
+		return iter->second;
+
+	int id = vocabulary->size() + 1;
+	vocabulary->insert(iter, make_pair(item, id));
+	items->push_back(item);
+	return id;
+}
+
+size_t TaggedCorpusIndex::freq(MixedNgram const &ngram) const
+{
+	if (ngram.empty() || d_wordSuffixArray.isNull())
+		return 0;
+
+	for (MixedNgram::const_iterator iter = ngram.begin();
+			iter != ngram.end(); ++iter)
+		if (iter->id < 0)
+			return 0;
+
+	// Look up every run of words or tags, and pick the run with the
+	// fewest occurrences as the anchor.
+	size_t anchorBegin = 0;
+	size_t anchorEnd = 0;
+	SuffixArray<int>::IterPair anchorMatches;
+
+	for (size_t runBegin = 0; runBegin < ngram.size(); )
+	{
+		TaggedItem::Type type = ngram[runBegin].type;
+
+		vector<int> run;
+		size_t runEnd = runBegin;
+		for (; runEnd < ngram.size() && ngram[runEnd].type == type; ++runEnd)
+			run.push_back(ngram[runEnd].id);
+
+		SuffixArray<int> const &suffixArray = type == TaggedItem::WORD ?
+			*d_wordSuffixArray : *d_tagSuffixArray;
+		SuffixArray<int>::IterPair matches =
+			suffixArray.find(run.begin(), run.end());
+
+		if (matches.first == matches.second)
+			return 0;
+
+		if (runBegin == 0 || matches.second - matches.first <
+				anchorMatches.second - anchorMatches.first)
+		{
+			anchorBegin = runBegin;
+			anchorEnd = runEnd;
+			anchorMatches = matches;
+		}
+
+		runBegin = runEnd;
+	}
+
+	// The n-gram consists of a single run.
+	if (anchorBegin == 0 && anchorEnd == ngram.size())
+		return anchorMatches.second - anchorMatches.first;
+
+	vector<int> const &words = *d_wordStream;
+	vector<int> const &tags = *d_tagStream;
+
+	size_t freq = 0;
+	for (vector<size_t>::const_iterator iter = anchorMatches.first;
+			iter != anchorMatches.second; ++iter)
+	{
+		if (*iter < anchorBegin)
+			continue;
+
+		size_t start = *iter - anchorBegin;
+		if (start + ngram.size() > words.size())
+			continue;
+
+		bool match = true;
+		for (size_t i = 0; match && i < ngram.size(); ++i)
+		{
+			if (i == anchorBegin)
+			{
+				i = anchorEnd - 1;
+				continue;
+			}
+
+			vector<int> const &stream = ngram[i].type == TaggedItem::WORD ?
+				words : tags;
+			match = stream[start + i] == ngram[i].id;
+		}
+
+		if (match)
+			++freq;
+	}
+
+	return freq;
+}
+
+void TaggedCorpusIndex::index(SuffixArray<int>::SortAlgorithm sortAlgorithm)
+{
+	// ssort requires at least one sentence end marker.
+	if (d_nSentences == 0)
+		sortAlgorithm = SuffixArray<int>::STLSORT;
+
+	d_wordSuffixArray = SuffixArrayPtr(new SuffixArray<int>(
+		QSharedPointer<vector<int> const>(d_wordStream), sortAlgorithm));
+	d_tagSuffixArray = SuffixArrayPtr(new SuffixArray<int>(
+		QSharedPointer<vector<int> const>(d_tagStream), sortAlgorithm));
+}
+
+string const &TaggedCorpusIndex::item(vector<string> const &items, int id)
+{
+	if (id < 1 || static_cast<size_t>(id) > items.size())
+		throw runtime_error("Unknown word or tag identifier");
+
+	return items[id - 1];
+}
+
+int TaggedCorpusIndex::lookup(Vocabulary const &vocabulary,
+	string const &item)
+{
+	Vocabulary::const_iterator iter = vocabulary.find(item);
+	if (iter == vocabulary.end())
+		return -1;
+
+	return iter->second;
+}
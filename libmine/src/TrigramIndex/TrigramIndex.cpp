@@ -0,0 +1,248 @@
+#include "TrigramIndex.ih"
+
+namespace {
+
+void appendVarint(string *data, quint32 value)
+{
+	while (value >= 0x80)
+	{
+		data->push_back(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+
+	data->push_back(static_cast<char>(value));
+}
+
+inline bool isContinuationByte(char c)
+{
+	return (static_cast<unsigned char>(c) & 0xc0) == 0x80;
+}
+
+inline bool isQuantifier(char c)
+{
+	return c == '*' || c == '+' || c == '?' || c == '{';
+}
+
+// Return the last (UTF-8) character of a literal.
+string lastChar(string const &literal)
+{
+	size_t pos = literal.size();
+	while (pos > 0 && isContinuationByte(literal[pos - 1]))
+		--pos;
+	if (pos > 0)
+		--pos;
+
+	return literal.substr(pos);
+}
+
+void endLiteral(string *literal, vector<string> *literals)
+{
+	if (literal->size() >= 3)
+		literals->push_back(*literal);
+	literal->clear();
+}
+
+// Return the position after the escape sequence at pos.
+size_t skipEscape(string const &pattern, size_t pos)
+{
+	pos += 1;
+	if (pos == pattern.size())
+		return pos;
+
+	char c = pattern[pos++];
+
+	// Character codes (\xhhhh and \0ooo).
+	if (c == 'x')
+		for (size_t i = 0; i < 4 && pos < pattern.size() &&
+				isxdigit(static_cast<unsigned char>(pattern[pos])); ++i)
+			++pos;
+	else if (c == '0')
+		for (size_t i = 0; i < 3 && pos < pattern.size() &&
+				pattern[pos] >= '0' && pattern[pos] <= '7'; ++i)
+			++pos;
+
+	return pos;
+}
+
+// Return the position after the character class that starts at pos.
+size_t skipClass(string const &pattern, size_t pos)
+{
+	++pos;
+	if (pos < pattern.size() && pattern[pos] == '^')
+		++pos;
+	// A closing bracket at the start is part of the class.
+	if (pos < pattern.size() && pattern[pos] == ']')
+		++pos;
+
+	while (pos < pattern.size() && pattern[pos] != ']')
+		pos = pattern[pos] == '\\' ? skipEscape(pattern, pos) : pos + 1;
+
+	return min(pos + 1, pattern.size());
+}
+
+// Return the position after the group that starts at pos.
+size_t skipGroup(string const &pattern, size_t pos)
+{
+	size_t depth = 0;
+	while (pos < pattern.size())
+	{
+		char c = pattern[pos];
+		if (c == '\\')
+			pos = skipEscape(pattern, pos);
+		else if (c == '[')
+			pos = skipClass(pattern, pos);
+		else
+		{
+			++pos;
+			if (c == '(')
+				++depth;
+			else if (c == ')' && --depth == 0)
+				break;
+		}
+	}
+
+	return pos;
+}
+
+}
+
+void TrigramIndex::add(quint32 sentenceId, char const *text, size_t len)
+{
+	vector<quint32> sentenceTrigrams(trigrams(text, len));
+	for (vector<quint32>::const_iterator iter = sentenceTrigrams.begin();
+			iter != sentenceTrigrams.end(); ++iter)
+	{
+		// Posting lists start at zero, so the first identifier is stored
+		// as is.
+		quint32 &lastId = d_lastIds[*iter];
+		appendVarint(&d_postings[*iter], sentenceId - lastId);
+		lastId = sentenceId;
+	}
+}
+
+void TrigramIndex::decode(char const *data, size_t len, Postings *postings)
+{
+	quint32 id = 0;
+	size_t pos = 0;
+	while (pos < len)
+	{
+		quint32 delta = 0;
+		int shift = 0;
+		unsigned char byte;
+		do {
+			byte = static_cast<unsigned char>(data[pos++]);
+			delta |= static_cast<quint32>(byte & 0x7f) << shift;
+			shift += 7;
+		} while ((byte & 0x80) && pos < len);
+
+		id += delta;
+		postings->push_back(id);
+	}
+}
+
+TrigramIndex::Postings TrigramIndex::intersect(Postings const &postings1,
+	Postings const &postings2)
+{
+	Postings result;
+	set_intersection(postings1.begin(), postings1.end(),
+		postings2.begin(), postings2.end(), back_inserter(result));
+	return result;
+}
+
+vector<string> TrigramIndex::regExpLiterals(string const &pattern)
+{
+	vector<string> literals;
+	string literal;
+
+	size_t pos = 0;
+	while (pos < pattern.size())
+	{
+		char c = pattern[pos];
+
+		if (c == '|')
+			// Any top-level alternative could match, nothing is required.
+			return vector<string>();
+		else if (c == '\\')
+		{
+			char next = pos + 1 < pattern.size() ? pattern[pos + 1] : '\0';
+			if (next != '\0' && static_cast<unsigned char>(next) < 0x80 &&
+					!isalnum(static_cast<unsigned char>(next)))
+			{
+				// Escaped special character.
+				literal.push_back(next);
+				pos += 2;
+			}
+			else
+			{
+				// Character classes, assertions, back references, and
+				// character codes.
+				endLiteral(&literal, &literals);
+				pos = skipEscape(pattern, pos);
+			}
+		}
+		else if (c == '[')
+		{
+			endLiteral(&literal, &literals);
+			pos = skipClass(pattern, pos);
+		}
+		else if (c == '(')
+		{
+			// Groups can contain alternatives or be lookaheads, so their
+			// contents are not required.
+			endLiteral(&literal, &literals);
+			pos = skipGroup(pattern, pos);
+		}
+		else if (isQuantifier(c))
+		{
+			bool once = c == '+' &&
+				(pos + 1 == pattern.size() || !isQuantifier(pattern[pos + 1]));
+
+			// The quantified character is required once for '+', the
+			// following text comes after a repetition of it.
+			string quantified(lastChar(literal));
+			if (!once)
+				literal.erase(literal.size() - quantified.size());
+			endLiteral(&literal, &literals);
+			if (once)
+				literal = quantified;
+
+			if (c == '{')
+				while (pos < pattern.size() && pattern[pos] != '}')
+					++pos;
+			++pos;
+		}
+		else if (c == '.' || c == '^' || c == '$' || c == ')')
+		{
+			endLiteral(&literal, &literals);
+			++pos;
+		}
+		else
+		{
+			literal.push_back(c);
+			++pos;
+		}
+	}
+
+	endLiteral(&literal, &literals);
+
+	return literals;
+}
+
+vector<quint32> TrigramIndex::trigrams(char const *text, size_t len)
+{
+	vector<quint32> result;
+	if (len < 3)
+		return result;
+
+	result.reserve(len - 2);
+	for (size_t i = 0; i + 2 < len; ++i)
+		result.push_back(
+			(static_cast<quint32>(static_cast<unsigned char>(text[i])) << 16) |
+			(static_cast<quint32>(static_cast<unsigned char>(text[i + 1])) << 8) |
+			static_cast<quint32>(static_cast<unsigned char>(text[i + 2])));
+
+	sort(result.begin(), result.end());
+	result.erase(unique(result.begin(), result.end()), result.end());
+
+	return result;
+}
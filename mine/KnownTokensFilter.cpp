@@ -0,0 +1,21 @@
+#include "KnownTokensFilter.ih"
+
+void KnownTokensFilter::handleSentence(vector<string> const &tokens,
+	double error)
+{
+	HashAutomaton const &hashAutomaton = error == 0.0 ?
+		*d_parsableHashAutomaton : *d_unparsableHashAutomaton;
+
+	for (vector<string>::const_iterator iter = tokens.begin();
+			iter != tokens.end(); ++iter)
+		if (hashAutomaton(*iter) == -1)
+		{
+			if (error == 0.0)
+				++d_nParsableSkipped;
+			else
+				++d_nUnparsableSkipped;
+			return;
+		}
+
+	d_handler->handleSentence(tokens, error);
+}
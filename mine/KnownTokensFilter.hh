@@ -0,0 +1,55 @@
+#ifndef KNOWN_TOKENS_FILTER_HH_
+#define KNOWN_TOKENS_FILTER_HH_
+
+#include <string>
+#include <vector>
+
+#include <errormining/Expander.hh>
+#include <errormining/SentenceHandler.hh>
+
+/**
+ * A sentence handler that passes sentences on to another handler, if all
+ * tokens of the sentence are known to the hash automaton of its corpus.
+ * The perfect hash automata can not be extended, so sentences with new
+ * words can not be mined until the automata are rebuilt.
+ */
+class KnownTokensFilter : public errormining::SentenceHandler
+{
+public:
+	KnownTokensFilter(errormining::SentenceHandler *handler,
+		errormining::HashAutomatonPtr parsableHashAutomaton,
+		errormining::HashAutomatonPtr unparsableHashAutomaton) :
+		d_handler(handler), d_parsableHashAutomaton(parsableHashAutomaton),
+		d_unparsableHashAutomaton(unparsableHashAutomaton),
+		d_nParsableSkipped(0), d_nUnparsableSkipped(0) {}
+
+	void handleSentence(std::vector<std::string> const &tokens, double error);
+
+	/**
+	 * Return the number of parsable sentences that were skipped.
+	 */
+	size_t nParsableSkipped() const;
+
+	/**
+	 * Return the number of unparsable sentences that were skipped.
+	 */
+	size_t nUnparsableSkipped() const;
+private:
+	errormining::SentenceHandler *d_handler;
+	errormining::HashAutomatonPtr d_parsableHashAutomaton;
+	errormining::HashAutomatonPtr d_unparsableHashAutomaton;
+	size_t d_nParsableSkipped;
+	size_t d_nUnparsableSkipped;
+};
+
+inline size_t KnownTokensFilter::nParsableSkipped() const
+{
+	return d_nParsableSkipped;
+}
+
+inline size_t KnownTokensFilter::nUnparsableSkipped() const
+{
+	return d_nUnparsableSkipped;
+}
+
+#endif // KNOWN_TOKENS_FILTER_HH_
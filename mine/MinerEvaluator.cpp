@@ -0,0 +1,110 @@
+#include "MinerEvaluator.ih"
+
+MinerEvaluator::Ngrams MinerEvaluator::parsableNgrams(Forms const &ranking) const
+{
+	// Every token is converted only once.
+	QHash<int, int> parsableIds;
+
+	Ngrams ngrams(ranking.size());
+	for (size_t i = 0; i < ranking.size(); ++i)
+	{
+		vector<int> const &ngram = ranking[i]->ngram();
+		vector<int> &parsableNgram = ngrams[i];
+
+		for (vector<int>::const_iterator tokenIter = ngram.begin();
+				tokenIter != ngram.end(); ++tokenIter)
+		{
+			QHash<int, int>::const_iterator idIter = parsableIds.find(*tokenIter);
+			if (idIter == parsableIds.end())
+				idIter = parsableIds.insert(*tokenIter,
+					(*d_parsableHashAutomaton)((*d_unparsableHashAutomaton)(*tokenIter)));
+
+			// The n-gram does not occur in the parsable corpus.
+			if (idIter.value() == -1)
+			{
+				parsableNgram.clear();
+				break;
+			}
+
+			parsableNgram.push_back(idIter.value());
+		}
+	}
+
+	return ngrams;
+}
+
+void MinerEvaluator::addParsableLinks(quint32 form, vector<int> const &ngram,
+	quint32 firstSentence, vector<FormSentenceIncidence::Link> *links) const
+{
+	if (ngram.empty())
+		return;
+
+	vector<size_t> const &starts = *d_hashedCorpus->goodSentenceStarts();
+	size_t corpusSize = d_hashedCorpus->good()->size();
+
+	SuffixArray<int>::IterPair iters = d_goodSuffixArray->find(ngram.begin(),
+		ngram.end());
+	for (vector<size_t>::const_iterator iter = iters.first;
+			iter != iters.second; ++iter)
+	{
+		// The sentence that contains the start of the occurrence.
+		vector<size_t>::const_iterator next = upper_bound(starts.begin(),
+			starts.end(), *iter);
+		size_t sentenceEnd = next == starts.end() ? corpusSize : *next;
+
+		// The corpus has no sentence boundaries, skip occurrences that
+		// cross one.
+		if (*iter + ngram.size() > sentenceEnd)
+			continue;
+
+		links->push_back(make_pair(form,
+			firstSentence + static_cast<quint32>(distance(starts.begin(), next) - 1)));
+	}
+}
+
+vector<EvaluationPoint> MinerEvaluator::evaluate(Miner const &miner,
+	Forms const &ranking, Ngrams const &parsableNgrams) const
+{
+	// Forms are numbered by their rank.
+	QHash<Form const *, quint32> ranks;
+	ranks.reserve(ranking.size());
+	for (size_t i = 0; i < ranking.size(); ++i)
+		ranks.insert(ranking[i], i);
+
+	// Unparsable sentences are numbered first, the parsable sentences
+	// follow.
+	vector<FormSentenceIncidence::Link> links;
+	list<Sentence> const &sentences = miner.sentences();
+	quint32 sentence = 0;
+	for (list<Sentence>::const_iterator sentenceIter = sentences.begin();
+			sentenceIter != sentences.end(); ++sentenceIter, ++sentence)
+		for (Sentence::const_iterator formIter = sentenceIter->begin();
+				formIter != sentenceIter->end(); ++formIter)
+		{
+			QHash<Form const *, quint32>::const_iterator rankIter =
+				ranks.find(*formIter);
+			if (rankIter != ranks.end())
+				links.push_back(make_pair(rankIter.value(), sentence));
+		}
+
+	size_t nUnparsable = sentences.size();
+	for (size_t i = 0; i < ranking.size(); ++i)
+		addParsableLinks(i, parsableNgrams[i], nUnparsable, &links);
+
+	vector<bool> unparsable(nUnparsable +
+		d_hashedCorpus->goodSentenceStarts()->size(), false);
+	fill(unparsable.begin(), unparsable.begin() + nUnparsable, true);
+
+	FormSentenceIncidence incidence(links, unparsable);
+
+	// The links are not needed anymore.
+	vector<FormSentenceIncidence::Link>().swap(links);
+
+	RankingEvaluator evaluator(incidence, d_beta);
+	vector<EvaluationPoint> curve;
+	curve.reserve(ranking.size());
+	for (size_t i = 0; i < ranking.size(); ++i)
+		curve.push_back(evaluator.add(i));
+
+	return curve;
+}
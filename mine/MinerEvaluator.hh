@@ -0,0 +1,82 @@
+#ifndef MINER_EVALUATOR_HH_
+#define MINER_EVALUATOR_HH_
+
+#include <vector>
+
+#include <QSharedPointer>
+
+#include <errormining/Expander.hh>
+#include <errormining/Form.hh>
+#include <errormining/FormSentenceIncidence.hh>
+#include <errormining/HashedCorpus.hh>
+#include <errormining/Miner.hh>
+#include <errormining/RankingEvaluator.hh>
+
+/**
+ * Evaluates the ranking of a miner in the same manner as miningeval,
+ * without building a mining database. The unparsable sentences in which
+ * a form occurs are the sentences in which the miner observed it, the
+ * parsable sentences are found with the suffix array of the parsable
+ * corpus.
+ */
+class MinerEvaluator
+{
+public:
+	typedef std::vector<errormining::Form const *> Forms;
+	typedef std::vector<std::vector<int> > Ngrams;
+
+	/**
+	 * Construct an evaluator.
+	 *
+	 * @param parsableHashAutomaton The hash automaton of the parsable corpus.
+	 * @param unparsableHashAutomaton The hash automaton of the unparsable
+	 *  corpus, this is used to decode forms.
+	 * @param hashedCorpus The hashed corpus, with the parsable sentences.
+	 * @param goodSuffixArray The suffix array of the parsable corpus.
+	 * @param beta The beta of the weighted F-score.
+	 */
+	MinerEvaluator(errormining::HashAutomatonPtr parsableHashAutomaton,
+		errormining::HashAutomatonPtr unparsableHashAutomaton,
+		QSharedPointer<errormining::HashedCorpus const> hashedCorpus,
+		errormining::SuffixArrayPtr goodSuffixArray, double beta = 0.5) :
+		d_parsableHashAutomaton(parsableHashAutomaton),
+		d_unparsableHashAutomaton(unparsableHashAutomaton),
+		d_hashedCorpus(hashedCorpus), d_goodSuffixArray(goodSuffixArray),
+		d_beta(beta) {}
+
+	/**
+	 * Convert the n-grams of the forms of a ranking to parsable hash codes.
+	 * This uses the hash automata, so it should not be called while
+	 * another thread uses them. N-grams with tokens that do not occur in
+	 * the parsable corpus are empty.
+	 */
+	Ngrams parsableNgrams(Forms const &ranking) const;
+
+	/**
+	 * Evaluate a ranking of the forms of a miner. Returns the evaluation
+	 * after each form of the ranking. This does not use the hash automata,
+	 * and can run in parallel with writing the results.
+	 *
+	 * @param miner The miner that holds the forms and the unparsable
+	 *  sentences.
+	 * @param ranking The ranked forms.
+	 * @param parsableNgrams The n-grams of the ranking, as returned by
+	 *  parsableNgrams().
+	 */
+	std::vector<errormining::EvaluationPoint> evaluate(
+		errormining::Miner const &miner, Forms const &ranking,
+		Ngrams const &parsableNgrams) const;
+private:
+	// Find the parsable sentences in which an n-gram occurs.
+	void addParsableLinks(quint32 form, std::vector<int> const &ngram,
+		quint32 firstSentence,
+		std::vector<errormining::FormSentenceIncidence::Link> *links) const;
+
+	errormining::HashAutomatonPtr d_parsableHashAutomaton;
+	errormining::HashAutomatonPtr d_unparsableHashAutomaton;
+	QSharedPointer<errormining::HashedCorpus const> d_hashedCorpus;
+	errormining::SuffixArrayPtr d_goodSuffixArray;
+	double d_beta;
+};
+
+#endif // MINER_EVALUATOR_HH_
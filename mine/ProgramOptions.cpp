@@ -1,10 +1,12 @@
 #include "ProgramOptions.ih"
 
 ProgramOptions::ProgramOptions(int argc, char *argv[])
-	: d_n(1), d_m(1), d_ngramExpansion(true), d_expansionFactorAlpha(1.0),
-	d_frequency(2), d_smoothing(false), d_smoothingBeta(0.1),
+	: d_checkpointInterval(10), d_n(1), d_m(1), d_ngramExpansion(true),
+	d_expansionFactorAlpha(1.0), d_frequency(2), d_resume(false),
+	d_smoothing(false), d_smoothingBeta(0.1),
 	d_sortAlgorithm(SuffixArray<int>::SSORT), d_suspFrequency(0),
-	d_suspThreshold(0.001), d_threshold(0.001), d_verbose(true),
+	d_suspThreshold(0.001), d_tagExpansion(false), d_threshold(0.001),
+	d_topK(0), d_verbose(true),
 	d_arguments(new vector<string>())
 {
 	d_programName = argv[0];
@@ -13,7 +15,7 @@ ProgramOptions::ProgramOptions(int argc, char *argv[])
 	opterr = 0;
 
 	int opt;
-	while ((opt = getopt(argc, argv, "b:ce:f:m:n:o:qs:t:u")) != -1)
+	while ((opt = getopt(argc, argv, "b:ce:E:f:g:i:k:m:n:o:p:qrs:t:Tu:U:w:")) != -1)
 	{
 		switch (opt)
 		{
@@ -27,9 +29,21 @@ ProgramOptions::ProgramOptions(int argc, char *argv[])
 		case 'e':
 			d_expansionFactorAlpha = parseString<double>(optarg);
 			break;
+		case 'E':
+			d_evaluationFilename = optarg;
+			break;
 		case 'f':
 			d_frequency = parseString<size_t>(optarg);
 			break;
+		case 'g':
+			d_sweepGrid = optarg;
+			break;
+		case 'i':
+			d_checkpointInterval = parseString<size_t>(optarg);
+			break;
+		case 'k':
+			d_topK = parseString<size_t>(optarg);
+			break;
 		case 'm':
 			d_m = parseString<size_t>(optarg);
 			break;
@@ -45,18 +59,33 @@ ProgramOptions::ProgramOptions(int argc, char *argv[])
 					throw string("Unknown suffix sorting algorithm: " + algo);
 			}
 			break;
+		case 'p':
+			d_checkpointFilename = optarg;
+			break;
 		case 'q':
 			d_verbose = false;
 			break;
+		case 'r':
+			d_resume = true;
+			break;
 		case 's':
 			d_suspThreshold = parseString<double>(optarg);
 			break;
 		case 't':
 			d_threshold = parseString<double>(optarg);
 			break;
+		case 'T':
+			d_tagExpansion = true;
+			break;
 		case 'u':
 			d_suspFrequency = parseString<size_t>(optarg);
 			break;
+		case 'U':
+			d_batchesFilename = optarg;
+			break;
+		case 'w':
+			d_binaryResultsFilename = optarg;
+			break;
 		case ':':
 			throw string("Missing option argument for: -") +
 				static_cast<char>(optopt);
@@ -66,5 +95,34 @@ ProgramOptions::ProgramOptions(int argc, char *argv[])
 		}
 	}
 
+	if (d_resume && d_checkpointFilename.empty())
+		throw string("Resuming requires a checkpoint file (-p)");
+
+	if (d_resume && !d_evaluationFilename.empty())
+		throw string("Evaluation requires the parsable sentences, and can not be combined with resuming (-r)");
+
+	if (!d_batchesFilename.empty())
+	{
+		if (d_binaryResultsFilename.empty())
+			throw string("Incremental mining requires a results prefix (-w)");
+		if (d_resume || !d_sweepGrid.empty() || !d_evaluationFilename.empty())
+			throw string("Incremental mining can not be combined with -r, -g or -E");
+	}
+
+	if (!d_sweepGrid.empty())
+	{
+		if (d_binaryResultsFilename.empty())
+			throw string("A parameter sweep requires a results prefix (-w)");
+		if (d_resume || !d_checkpointFilename.empty())
+			throw string("A parameter sweep can not be combined with checkpoints");
+	}
+
+	// Forms of mixed words and tags can only be decoded with the tagged
+	// corpora that they were expanded from.
+	if (d_tagExpansion && (!d_ngramExpansion || d_resume ||
+			!d_checkpointFilename.empty() || !d_batchesFilename.empty() ||
+			!d_sweepGrid.empty() || !d_evaluationFilename.empty()))
+		throw string("Tag expansion can not be combined with -c, -E, -g, -p, -r or -U");
+
 	copy(argv + optind, argv + argc, back_inserter(*d_arguments));
 }
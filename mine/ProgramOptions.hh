@@ -15,36 +15,54 @@ class ProgramOptions
 public:
 	ProgramOptions(int argc, char *argv[]);
 	std::vector<std::string> const &arguments() const;
+	std::string const &batchesFilename() const;
+	std::string const &checkpointFilename() const;
+	size_t checkpointInterval() const;
+	std::string const &evaluationFilename() const;
 	double expansionFactorAlpha() const;
 	size_t n() const;
 	size_t m() const;
 	size_t ngramExpansion() const;
 	size_t frequency() const;
 	std::string const &programName() const;
+	bool resume() const;
+	size_t topK() const;
 	bool smoothing() const;
 	double smoothingBeta() const;
-	errormining::SuffixArray<int>::SortAlgorithm sortAlgorithm();
+	errormining::SuffixArray<int>::SortAlgorithm sortAlgorithm() const;
 	size_t suspFrequency() const;
 	double suspThreshold() const;
+	std::string const &sweepGrid() const;
+	bool tagExpansion() const;
 	double threshold() const;
 	bool verbose() const;
+	std::string const &binaryResultsFilename() const;
 private:
 	ProgramOptions(ProgramOptions const &other);
 	ProgramOptions &operator=(ProgramOptions const &other);
 
 	std::string d_programName;
+	std::string d_batchesFilename;
+	std::string d_checkpointFilename;
+	size_t d_checkpointInterval;
 	size_t d_n;
 	size_t d_m;
 	bool d_ngramExpansion;
+	std::string d_evaluationFilename;
 	double d_expansionFactorAlpha;
 	size_t d_frequency;
+	bool d_resume;
 	bool d_smoothing;
 	double d_smoothingBeta;
 	errormining::SuffixArray<int>::SortAlgorithm d_sortAlgorithm;
 	size_t d_suspFrequency;
 	double d_suspThreshold;
+	std::string d_sweepGrid;
+	bool d_tagExpansion;
 	double d_threshold;
+	size_t d_topK;
 	bool d_verbose;
+	std::string d_binaryResultsFilename;
 	QSharedPointer<std::vector<std::string> > d_arguments;
 };
 
@@ -66,6 +84,26 @@ inline std::vector<std::string> const &ProgramOptions::arguments() const
 	return *d_arguments;
 }
 
+inline std::string const &ProgramOptions::batchesFilename() const
+{
+	return d_batchesFilename;
+}
+
+inline std::string const &ProgramOptions::checkpointFilename() const
+{
+	return d_checkpointFilename;
+}
+
+inline size_t ProgramOptions::checkpointInterval() const
+{
+	return d_checkpointInterval;
+}
+
+inline std::string const &ProgramOptions::evaluationFilename() const
+{
+	return d_evaluationFilename;
+}
+
 inline double ProgramOptions::expansionFactorAlpha() const
 {
 	return d_expansionFactorAlpha;
@@ -96,6 +134,11 @@ inline std::string const &ProgramOptions::programName() const
 	return d_programName;
 }
 
+inline bool ProgramOptions::resume() const
+{
+	return d_resume;
+}
+
 inline bool ProgramOptions::smoothing() const
 {
 	return d_smoothing;
@@ -106,7 +149,7 @@ inline double ProgramOptions::smoothingBeta() const
 	return d_smoothingBeta;
 }
 
-inline errormining::SuffixArray<int>::SortAlgorithm ProgramOptions::sortAlgorithm()
+inline errormining::SuffixArray<int>::SortAlgorithm ProgramOptions::sortAlgorithm() const
 {
 	return d_sortAlgorithm;
 }
@@ -121,14 +164,34 @@ inline double ProgramOptions::suspThreshold() const
 	return d_suspThreshold;
 }
 
+inline std::string const &ProgramOptions::sweepGrid() const
+{
+	return d_sweepGrid;
+}
+
+inline bool ProgramOptions::tagExpansion() const
+{
+	return d_tagExpansion;
+}
+
 inline double ProgramOptions::threshold() const
 {
 	return d_threshold;
 }
 
+inline size_t ProgramOptions::topK() const
+{
+	return d_topK;
+}
+
 inline bool ProgramOptions::verbose() const
 {
 	return d_verbose;
 }
 
+inline std::string const &ProgramOptions::binaryResultsFilename() const
+{
+	return d_binaryResultsFilename;
+}
+
 #endif // PROGRAM_OPTIONS_HH_
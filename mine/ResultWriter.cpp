@@ -0,0 +1,156 @@
+#include "ResultWriter.ih"
+
+namespace {
+
+// The number of forms that are formatted as one chunk.
+size_t const CHUNK_SIZE = 65536;
+
+}
+
+QByteArray ResultWriter::FormatChunk::operator()(FormsRange const &range) const
+{
+	QByteArray buffer;
+	buffer.reserve(distance(range.first, range.second) * 32);
+
+	char numbers[64];
+	for (Forms::const_iterator formIter = range.first;
+			formIter != range.second; ++formIter)
+	{
+		Form const *form = *formIter;
+
+		for (vector<int>::const_iterator tokenIter = form->ngram().begin();
+				tokenIter != form->ngram().end(); ++tokenIter)
+		{
+			string const &token = (*d_vocabulary)[*tokenIter];
+			buffer.append(token.data(), token.size());
+			buffer.append(' ');
+		}
+
+		// %g gives the same representation as the default formatting of
+		// doubles by iostreams.
+		int len = snprintf(numbers, sizeof(numbers), "%g %lu %lu\n",
+			form->suspicion(),
+			static_cast<unsigned long>(form->nObservations()),
+			static_cast<unsigned long>(form->nSuspObservations()));
+		buffer.append(numbers, len);
+	}
+
+	return buffer;
+}
+
+vector<string> ResultWriter::decodeVocabulary(Forms const &forms) const
+{
+	// Find the identifiers that are used by the forms, so that we do not
+	// have to decode the full vocabulary.
+	vector<bool> used;
+	for (Forms::const_iterator formIter = forms.begin();
+			formIter != forms.end(); ++formIter)
+		for (vector<int>::const_iterator tokenIter = (*formIter)->ngram().begin();
+				tokenIter != (*formIter)->ngram().end(); ++tokenIter)
+		{
+			if (*tokenIter < 0)
+				throw runtime_error("Form with an unknown token");
+
+			size_t id = *tokenIter;
+			if (id >= used.size())
+				used.resize(id + 1, false);
+			used[id] = true;
+		}
+
+	// Walking the automaton is not thread-safe, so decode all identifiers
+	// up-front.
+	vector<string> vocabulary(used.size());
+	for (size_t id = 0; id < used.size(); ++id)
+		if (used[id])
+			vocabulary[id] = d_tagExpander.isNull() ?
+				(*d_hashAutomaton)(static_cast<int>(id)) :
+				d_tagExpander->itemString(static_cast<int>(id));
+
+	return vocabulary;
+}
+
+void ResultWriter::write(Forms const &forms) const
+{
+	vector<string> vocabulary(decodeVocabulary(forms));
+
+	// Format chunks in waves, so that the amount of formatted output that
+	// is kept in memory is bounded.
+	size_t waveSize = max(QThread::idealThreadCount(), 1) * 2;
+
+	Forms::const_iterator iter = forms.begin();
+	while (iter != forms.end())
+	{
+		QList<FormsRange> chunks;
+		while (iter != forms.end() &&
+				static_cast<size_t>(chunks.size()) < waveSize)
+		{
+			Forms::const_iterator chunkEnd = iter +
+				min(CHUNK_SIZE, static_cast<size_t>(distance(iter, forms.end())));
+			chunks.push_back(make_pair(iter, chunkEnd));
+			iter = chunkEnd;
+		}
+
+		// The results of mapped() are delivered in the order of the chunks.
+		QFuture<QByteArray> formatted = QtConcurrent::mapped(chunks,
+			FormatChunk(&vocabulary));
+		for (int i = 0; i < chunks.size(); ++i)
+			writeBuffer(formatted.resultAt(i));
+	}
+}
+
+void ResultWriter::writeBinary(Forms const &forms, string const &filename) const
+{
+	vector<string> decoded(decodeVocabulary(forms));
+
+	// Only store the types that are used, numbered densely.
+	vector<int> typeIds(decoded.size(), -1);
+	vector<string> vocabulary;
+	for (Forms::const_iterator formIter = forms.begin();
+			formIter != forms.end(); ++formIter)
+		for (vector<int>::const_iterator tokenIter = (*formIter)->ngram().begin();
+				tokenIter != (*formIter)->ngram().end(); ++tokenIter)
+			if (typeIds[*tokenIter] == -1)
+			{
+				typeIds[*tokenIter] = vocabulary.size();
+				vocabulary.push_back(decoded[*tokenIter]);
+			}
+
+	MiningResults results(vocabulary);
+
+	vector<int> ngram;
+	for (Forms::const_iterator formIter = forms.begin();
+			formIter != forms.end(); ++formIter)
+	{
+		Form const *form = *formIter;
+
+		ngram.clear();
+		for (vector<int>::const_iterator tokenIter = form->ngram().begin();
+				tokenIter != form->ngram().end(); ++tokenIter)
+			ngram.push_back(typeIds[*tokenIter]);
+
+		results.addForm(ngram, form->suspicion(), form->nObservations(),
+			form->nSuspObservations());
+	}
+
+	results.write(filename);
+}
+
+void ResultWriter::writeBuffer(QByteArray const &buffer) const
+{
+	char const *data = buffer.constData();
+	size_t left = buffer.size();
+
+	while (left > 0)
+	{
+		ssize_t written = ::write(d_fd, data, left);
+		if (written == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			throw runtime_error("Could not write results");
+		}
+
+		data += written;
+		left -= written;
+	}
+}
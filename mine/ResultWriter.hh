@@ -0,0 +1,94 @@
+#ifndef RESULT_WRITER_HH_
+#define RESULT_WRITER_HH_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QByteArray>
+#include <QSharedPointer>
+
+#include <errormining/Form.hh>
+#include <errormining/HashAutomaton.hh>
+#include <errormining/TagExpander.hh>
+
+/**
+ * Writes mining results in the text format:
+ *
+ * [ngram] [suspicion] [f(ngram)] [f_unparsable(ngram)]
+ *
+ * or in the binary format of errormining::MiningResults.
+ *
+ * Every token identifier is decoded through the hash automaton only once.
+ * Text is formatted in large chunks, using multiple threads, and each
+ * chunk is written with a single write to the file descriptor.
+ */
+class ResultWriter
+{
+public:
+	typedef std::vector<errormining::Form const *> Forms;
+
+	/**
+	 * Construct a result writer.
+	 *
+	 * @param hashAutomaton The automaton that is used to decode n-grams.
+	 * @param fd The file descriptor to write to.
+	 */
+	ResultWriter(QSharedPointer<errormining::HashAutomaton const> hashAutomaton,
+		int fd = 1) :
+		d_hashAutomaton(hashAutomaton), d_fd(fd) {}
+
+	/**
+	 * Decode n-grams with the expander that created them, rather than
+	 * with the hash automaton. This is required for the mixed n-grams of
+	 * a tag expander.
+	 */
+	void setTagExpander(
+		QSharedPointer<errormining::TagExpander const> tagExpander);
+
+	/**
+	 * Write forms, in the order of the given vector.
+	 */
+	void write(Forms const &forms) const;
+
+	/**
+	 * Write forms in the binary results format, in the order of the
+	 * given vector.
+	 */
+	void writeBinary(Forms const &forms, std::string const &filename) const;
+private:
+	typedef std::pair<Forms::const_iterator, Forms::const_iterator> FormsRange;
+
+	ResultWriter(ResultWriter const &other);
+	ResultWriter &operator=(ResultWriter const &other);
+
+	// Format a range of forms.
+	struct FormatChunk
+	{
+		typedef QByteArray result_type;
+
+		FormatChunk(std::vector<std::string> const *vocabulary) :
+			d_vocabulary(vocabulary) {}
+		QByteArray operator()(FormsRange const &range) const;
+	private:
+		std::vector<std::string> const *d_vocabulary;
+	};
+
+	// Decode all token identifiers that occur in the given forms.
+	std::vector<std::string> decodeVocabulary(Forms const &forms) const;
+
+	// Write a buffer to the file descriptor.
+	void writeBuffer(QByteArray const &buffer) const;
+
+	QSharedPointer<errormining::HashAutomaton const> d_hashAutomaton;
+	QSharedPointer<errormining::TagExpander const> d_tagExpander;
+	int d_fd;
+};
+
+inline void ResultWriter::setTagExpander(
+	QSharedPointer<errormining::TagExpander const> tagExpander)
+{
+	d_tagExpander = tagExpander;
+}
+
+#endif // RESULT_WRITER_HH_
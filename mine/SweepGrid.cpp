@@ -0,0 +1,133 @@
+#include "SweepGrid.ih"
+
+string MiningConfig::name() const
+{
+	ostringstream oss;
+	oss << "n" << n;
+	if (ngramExpansion)
+		oss << ".e" << expansionFactorAlpha;
+	else
+		oss << ".m" << m;
+	oss << ".b" << (smoothing ? smoothingBeta : 0.0) << ".s" << suspThreshold <<
+		".t" << threshold;
+	return oss.str();
+}
+
+bool MiningConfig::sameExpansion(MiningConfig const &other) const
+{
+	if (n != other.n || ngramExpansion != other.ngramExpansion)
+		return false;
+
+	if (ngramExpansion)
+		return expansionFactorAlpha == other.expansionFactorAlpha;
+	else
+		return m == other.m;
+}
+
+template <typename T>
+vector<T> SweepGrid::parseValues(string const &param, string const &values)
+{
+	vector<T> parsed;
+
+	istringstream valuesStream(values);
+	string value;
+	while (getline(valuesStream, value, ','))
+	{
+		istringstream iss(value);
+		T val;
+		if (!(iss >> val) || !iss.eof())
+			throw runtime_error("Invalid value for grid parameter " + param +
+				": " + value);
+		parsed.push_back(val);
+	}
+
+	if (parsed.empty())
+		throw runtime_error("No values for grid parameter " + param);
+
+	return parsed;
+}
+
+SweepGrid::SweepGrid(string const &spec, ProgramOptions const &defaults)
+{
+	vector<size_t> ns(1, defaults.n());
+	vector<size_t> ms(1, defaults.m());
+	vector<double> alphas(1, defaults.expansionFactorAlpha());
+	vector<double> betas(1, defaults.smoothing() ? defaults.smoothingBeta() : 0.0);
+	vector<double> suspThresholds(1, defaults.suspThreshold());
+	vector<double> thresholds(1, defaults.threshold());
+
+	istringstream specStream(spec);
+	string paramSpec;
+	while (getline(specStream, paramSpec, ':'))
+	{
+		size_t sep = paramSpec.find('=');
+		if (sep == string::npos)
+			throw runtime_error("Invalid grid parameter: " + paramSpec);
+
+		string param = paramSpec.substr(0, sep);
+		string values = paramSpec.substr(sep + 1);
+
+		if (param == "n")
+			ns = parseValues<size_t>(param, values);
+		else if (param == "m")
+			ms = parseValues<size_t>(param, values);
+		else if (param == "e")
+			alphas = parseValues<double>(param, values);
+		else if (param == "b")
+			betas = parseValues<double>(param, values);
+		else if (param == "s")
+			suspThresholds = parseValues<double>(param, values);
+		else if (param == "t")
+			thresholds = parseValues<double>(param, values);
+		else
+			throw runtime_error("Unknown grid parameter: " + param);
+	}
+
+	// Expansion parameters are in the outer loops, so that every group
+	// of configurations that share an expansion is contiguous. Only the
+	// expansion parameters that are relevant to the expansion method are
+	// varied.
+	if (defaults.ngramExpansion())
+		ms.assign(1, defaults.m());
+	else
+		alphas.assign(1, defaults.expansionFactorAlpha());
+
+	MiningConfig config;
+	config.ngramExpansion = defaults.ngramExpansion();
+	for (vector<size_t>::const_iterator nIter = ns.begin(); nIter != ns.end(); ++nIter)
+		for (vector<size_t>::const_iterator mIter = ms.begin(); mIter != ms.end(); ++mIter)
+			for (vector<double>::const_iterator alphaIter = alphas.begin();
+					alphaIter != alphas.end(); ++alphaIter)
+			{
+				config.n = *nIter;
+				config.m = *mIter;
+				config.expansionFactorAlpha = *alphaIter;
+
+				Configs group;
+				for (vector<double>::const_iterator betaIter = betas.begin();
+						betaIter != betas.end(); ++betaIter)
+					for (vector<double>::const_iterator sIter = suspThresholds.begin();
+							sIter != suspThresholds.end(); ++sIter)
+						for (vector<double>::const_iterator tIter = thresholds.begin();
+								tIter != thresholds.end(); ++tIter)
+						{
+							config.smoothing = *betaIter > 0.0;
+							config.smoothingBeta = config.smoothing ? *betaIter :
+								defaults.smoothingBeta();
+							config.suspThreshold = *sIter;
+							config.threshold = *tIter;
+							group.push_back(config);
+						}
+
+				d_groups.push_back(group);
+			}
+}
+
+size_t SweepGrid::size() const
+{
+	size_t n = 0;
+	for (vector<Configs>::const_iterator iter = d_groups.begin();
+			iter != d_groups.end(); ++iter)
+		n += iter->size();
+	return n;
+}
@@ -0,0 +1,82 @@
+#ifndef SWEEP_GRID_HH_
+#define SWEEP_GRID_HH_
+
+#include <string>
+#include <vector>
+
+class ProgramOptions;
+
+/**
+ * The parameters of a single mining run in a parameter sweep.
+ */
+struct MiningConfig
+{
+	size_t n;
+	size_t m;
+	bool ngramExpansion;
+	double expansionFactorAlpha;
+	bool smoothing;
+	double smoothingBeta;
+	double suspThreshold;
+	double threshold;
+
+	/**
+	 * Return a name for this configuration that can be used in filenames,
+	 * e.g. "n2.e1.5.b0.1.s0.001.t0.001".
+	 */
+	std::string name() const;
+
+	/**
+	 * Returns true if this configuration gives the same expansion (and
+	 * thus the same forms and observations before mining) as another
+	 * configuration.
+	 */
+	bool sameExpansion(MiningConfig const &other) const;
+};
+
+/**
+ * A grid of mining configurations. The grid is specified as a
+ * colon-separated list of parameters with comma-separated values, e.g.:
+ *
+ * n=1,2:e=1.0,1.5:b=0,0.1:s=0.001,0.01:t=0.001
+ *
+ * Parameters are named after the corresponding options of mine (b, e, m,
+ * n, s and t), a smoothing beta of 0 disables smoothing. Parameters that
+ * are not in the grid take their value from the program options. The
+ * configurations are grouped by expansion, so that every expansion has
+ * to be performed only once.
+ */
+class SweepGrid
+{
+public:
+	typedef std::vector<MiningConfig> Configs;
+
+	/**
+	 * Construct a grid from a specification. Throws std::runtime_error
+	 * if the specification could not be parsed.
+	 */
+	SweepGrid(std::string const &spec, ProgramOptions const &defaults);
+
+	/**
+	 * Return the configurations, grouped by expansion.
+	 */
+	std::vector<Configs> const &groups() const;
+
+	/**
+	 * Return the total number of configurations.
+	 */
+	size_t size() const;
+private:
+	template <typename T>
+	static std::vector<T> parseValues(std::string const &param,
+		std::string const &values);
+
+	std::vector<Configs> d_groups;
+};
+
+inline std::vector<SweepGrid::Configs> const &SweepGrid::groups() const
+{
+	return d_groups;
+}
+
+#endif // SWEEP_GRID_HH_
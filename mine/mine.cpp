@@ -2,20 +2,35 @@
 #include <iostream>
 #include <iterator>
 #include <fstream>
+#include <sstream>
+#include <string>
 #include <vector>
 
+#include <QFuture>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSharedPointer>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
 
 #include <errormining/BestRatioExpander.hh>
+#include <errormining/DynamicSuffixArray.hh>
 #include <errormining/HashedCorpus.hh>
 #include <errormining/Miner.hh>
 #include <errormining/Observer.hh>
+#include <errormining/RankingEvaluator.hh>
 #include <errormining/SentenceHandler.hh>
 #include <errormining/SimpleExpander.hh>
 #include <errormining/SuffixArray.hh>
+#include <errormining/TagExpander.hh>
+#include <errormining/TaggedCorpusIndex.hh>
 #include <errormining/TokenizedSentenceReader.hh>
 
+#include "KnownTokensFilter.hh"
+#include "MinerEvaluator.hh"
 #include "ProgramOptions.hh"
+#include "ResultWriter.hh"
+#include "SweepGrid.hh"
 
 using namespace std;
 using namespace errormining;
@@ -33,6 +48,30 @@ void CycleNotifier::update(Observable const *)
 	cerr << ".";
 }
 
+// Adds sentences of word/tag tokens to the index of their corpus.
+class TaggedCorpusBuilder : public SentenceHandler
+{
+	TaggedCorpusIndex *d_goodIndex;
+	TaggedCorpusIndex *d_badIndex;
+public:
+	TaggedCorpusBuilder(TaggedCorpusIndex *goodIndex,
+		TaggedCorpusIndex *badIndex) :
+		d_goodIndex(goodIndex), d_badIndex(badIndex) {}
+	void handleSentence(vector<string> const &tokens, double error);
+};
+
+void TaggedCorpusBuilder::handleSentence(vector<string> const &tokens,
+	double error)
+{
+	vector<string> words(tokens.size());
+	vector<string> tags(tokens.size());
+	for (size_t i = 0; i < tokens.size(); ++i)
+		TagExpander::splitToken(tokens[i], &words[i], &tags[i]);
+
+	TaggedCorpusIndex *index = error == 0.0 ? d_goodIndex : d_badIndex;
+	index->addSentence(words, tags);
+}
+
 void usage(string const &programName)
 {
 		cerr << "Usage: " << programName <<
@@ -40,14 +79,29 @@ void usage(string const &programName)
 			"  -b val\tEnable smoothing, and set beta to val" << endl <<
 			"  -c\t\tDisable ngram expansion" << endl <<
 			"  -e val\tEnable use of an expansion factor, and set alpha to val" << endl <<
+			"  -E file\tEvaluate the ranking, and write the recall, precision" << endl <<
+			"\t\tand F-scores to file" << endl <<
 			"  -f freq\tShow forms observed >= freq" << endl <<
+			"  -g grid\tMine every configuration in a parameter grid, e.g." << endl <<
+			"\t\tn=1,2:e=1,1.5:b=0,0.1:s=0.001,0.01:t=0.001 (see README)" << endl <<
+			"  -i n\t\tWrite a checkpoint every n cycles (default: 10)" << endl <<
+			"  -k k\t\tOnly show the k most suspicious forms" << endl <<
 			"  -n n\t\tUse ngrams of length n" << endl <<
 			"  -m m\t\tCreate ngrams upto length m (only used with -c)" << endl <<
 			"  -o alg\tSort algorithm (stlsort or ssort, default: ssort)" << endl <<
+			"  -p file\tCheckpoint the mining state to file" << endl <<
 			"  -q\t\tBe quiet" << endl <<
+			"  -r\t\tResume from the checkpoint given with -p, the sentence" << endl <<
+			"\t\tfiles can be omitted" << endl <<
 			"  -s t\t\tSuspicion threshold for excluding suspicious observations" << endl <<
 			"  -t t\t\tThreshold for determining the fixed-point" << endl <<
-			"  -u freq\tShow forms observed >= freq in unparsable sentences" << endl << endl <<
+			"  -T\t\tExpand to n-grams of words and part-of-speech tags," << endl <<
+			"\t\tthe sentences consist of word/tag tokens (see README)" << endl <<
+			"  -U file\tAfter mining, read batches of new sentences from file" << endl <<
+			"\t\t('-' for standard input), see README" << endl <<
+			"  -u freq\tShow forms observed >= freq in unparsable sentences" << endl <<
+			"  -w file\tWrite results to file in the binary format, rather than" << endl <<
+			"\t\tas text to standard output" << endl << endl <<
 			"The perfect hash automata can be created with fsa_build:" << endl << endl <<
 			"tr -s '\\012\\011 ' '\\012' < oks.txt | LANG=POSIX LC_ALL=POSIX sort -u | \\" <<
 			endl << "  fsa_build -N -o oks.fsa" << endl << endl;
@@ -76,6 +130,405 @@ QSharedPointer<HashedCorpus> readHashedCorpus(ProgramOptions const &programOptio
 	return hashedCorpus;
 }
 
+QSharedPointer<HashedCorpus> createSuffixArrays(ProgramOptions const &programOptions,
+		QSharedPointer<HashAutomaton> parsableHashAutomaton,
+		QSharedPointer<HashAutomaton> unparsableHashAutomaton,
+		SuffixArrayPtr *goodSuffixArray, SuffixArrayPtr *badSuffixArray)
+{
+	// Read the corpus as a sequence of hash codes.
+	if (programOptions.verbose())
+		cerr << "Reading and hashing the corpus... ";
+	QSharedPointer<HashedCorpus> hashedCorpus = readHashedCorpus(programOptions,
+			parsableHashAutomaton, unparsableHashAutomaton);
+	if (programOptions.verbose())
+		cerr << "Done!" << endl << "Creating suffix arrays... ";
+
+	// Store the corpora as suffix arrays.
+	*goodSuffixArray = SuffixArrayPtr(new SuffixArray<int>(
+		hashedCorpus->good(), programOptions.sortAlgorithm()));
+	*badSuffixArray = SuffixArrayPtr(new SuffixArray<int>(
+		hashedCorpus->bad(), programOptions.sortAlgorithm()));
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl;
+
+	return hashedCorpus;
+}
+
+// SuffixArrayPtrType is SuffixArrayPtr, or DynamicSuffixArrayPtr in
+// incremental mode.
+template <typename SuffixArrayPtrType>
+ExpanderPtr createExpander(MiningConfig const &config,
+		QSharedPointer<HashAutomaton> parsableHashAutomaton,
+		QSharedPointer<HashAutomaton> unparsableHashAutomaton,
+		SuffixArrayPtrType goodSuffixArray, SuffixArrayPtrType badSuffixArray)
+{
+    QSharedPointer<Expander> expander;
+    if (config.ngramExpansion)
+        expander = QSharedPointer<Expander>(new BestRatioExpander(parsableHashAutomaton,
+            unparsableHashAutomaton, goodSuffixArray, badSuffixArray, config.n,
+            config.expansionFactorAlpha));
+    else
+        expander = QSharedPointer<Expander>(new SimpleExpander(parsableHashAutomaton,
+            unparsableHashAutomaton, goodSuffixArray, badSuffixArray, config.n,
+            config.m));
+
+	return expander;
+}
+
+MiningConfig defaultConfig(ProgramOptions const &programOptions)
+{
+	MiningConfig config;
+	config.n = programOptions.n();
+	config.m = programOptions.m();
+	config.ngramExpansion = programOptions.ngramExpansion();
+	config.expansionFactorAlpha = programOptions.expansionFactorAlpha();
+	config.smoothing = programOptions.smoothing();
+	config.smoothingBeta = programOptions.smoothingBeta();
+	config.suspThreshold = programOptions.suspThreshold();
+	config.threshold = programOptions.threshold();
+	return config;
+}
+
+void readSentences(ProgramOptions const &programOptions, Miner *miner)
+{
+	// Construct a sentence reader, and register the miner as a handler.
+	TokenizedSentenceReader reader;
+	reader.addHandler(miner);
+
+	ifstream badIn(programOptions.arguments()[3].c_str());
+	if (!badIn.good())
+		throw runtime_error("Could not read '" + programOptions.arguments()[3] +
+			"'!");
+
+	ifstream goodIn(programOptions.arguments()[2].c_str());
+	if (!goodIn.good())
+		throw runtime_error("Could not read '" + programOptions.arguments()[2] +
+			"'!");
+
+	if (programOptions.verbose())
+		cerr << "Reading parsable and unparsable sentences... ";
+
+	reader.read(goodIn, badIn);
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl;
+}
+
+// Evaluate a ranking, and write the curve in the format of miningeval,
+// without the forms. Returns an error message, or an empty string.
+string evaluateRanking(MinerEvaluator const *evaluator, Miner const *miner,
+	vector<Form const *> const *forms,
+	MinerEvaluator::Ngrams const *parsableNgrams, string const &filename)
+{
+	try {
+		vector<EvaluationPoint> curve = evaluator->evaluate(*miner, *forms,
+			*parsableNgrams);
+
+		ofstream out(filename.c_str());
+		if (!out.good())
+			throw runtime_error("Could not write evaluation to " + filename);
+
+		for (size_t i = 0; i < curve.size(); ++i)
+			out << i + 1 << "\t" << curve[i].recall << "\t" <<
+				curve[i].precision << "\t" << curve[i].fscore << "\t" <<
+				curve[i].betaFscore << "\n";
+
+		out.flush();
+		if (!out.good())
+			throw runtime_error("Could not write evaluation to " + filename);
+	} catch (runtime_error const &e) {
+		return e.what();
+	}
+
+	return string();
+}
+
+void readBatch(string const &parsableFilename,
+	string const &unparsableFilename, SentenceHandler *handler)
+{
+	ifstream badIn(unparsableFilename.c_str());
+	if (!badIn.good())
+		throw runtime_error("Could not read '" + unparsableFilename + "'!");
+
+	ifstream goodIn(parsableFilename.c_str());
+	if (!goodIn.good())
+		throw runtime_error("Could not read '" + parsableFilename + "'!");
+
+	TokenizedSentenceReader reader;
+	reader.addHandler(handler);
+	reader.read(goodIn, badIn);
+}
+
+// Index the tagged corpora, and create an expander to n-grams of words
+// and tags.
+QSharedPointer<TagExpander> createTagExpander(
+	ProgramOptions const &programOptions,
+	QSharedPointer<HashAutomaton> parsableHashAutomaton,
+	QSharedPointer<HashAutomaton> unparsableHashAutomaton)
+{
+	if (programOptions.verbose())
+		cerr << "Indexing the tagged corpus... ";
+
+	QSharedPointer<TaggedCorpusIndex> goodIndex(new TaggedCorpusIndex);
+	QSharedPointer<TaggedCorpusIndex> badIndex(new TaggedCorpusIndex);
+	TaggedCorpusBuilder builder(goodIndex.data(), badIndex.data());
+	readBatch(programOptions.arguments()[2], programOptions.arguments()[3],
+		&builder);
+
+	goodIndex->index(programOptions.sortAlgorithm());
+	badIndex->index(programOptions.sortAlgorithm());
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl;
+
+	return QSharedPointer<TagExpander>(new TagExpander(parsableHashAutomaton,
+		unparsableHashAutomaton, goodIndex, badIndex, programOptions.n(),
+		programOptions.expansionFactorAlpha()));
+}
+
+// Add a batch of new sentences to the index and the miner, and mine
+// from the current suspicions.
+void addBatch(ProgramOptions const &programOptions,
+	string const &parsableFilename, string const &unparsableFilename,
+	Miner *miner, Expander *expander, DynamicSuffixArray *goodIndex,
+	DynamicSuffixArray *badIndex,
+	QSharedPointer<HashAutomaton> parsableHashAutomaton,
+	QSharedPointer<HashAutomaton> unparsableHashAutomaton)
+{
+	// Hash the new sentences.
+	HashedCorpus batch(parsableHashAutomaton, unparsableHashAutomaton);
+	KnownTokensFilter corpusFilter(&batch, parsableHashAutomaton,
+		unparsableHashAutomaton);
+	readBatch(parsableFilename, unparsableFilename, &corpusFilter);
+
+	if (programOptions.verbose() && (corpusFilter.nParsableSkipped() != 0 ||
+			corpusFilter.nUnparsableSkipped() != 0))
+		cerr << "Skipped " << corpusFilter.nParsableSkipped() <<
+			" parsable and " << corpusFilter.nUnparsableSkipped() <<
+			" unparsable sentence(s) with unknown words" << endl;
+
+	// The identifiers in a batch are not dense, as McIlroy and McIlroy's
+	// algorithm requires, and batches are small, so they are sorted with
+	// STL sort.
+	SuffixArrayPtr goodBatch(new SuffixArray<int>(batch.good(),
+		SuffixArray<int>::STLSORT));
+	SuffixArrayPtr badBatch(new SuffixArray<int>(batch.bad(),
+		SuffixArray<int>::STLSORT));
+
+	// Known forms are observed in the new parsable sentences. This has
+	// to be done before new forms are created, since new forms get their
+	// frequencies from the updated index.
+	miner->addParsableSentences(*goodBatch);
+
+	goodIndex->add(goodBatch);
+	badIndex->add(badBatch);
+	expander->clearCache();
+
+	// Only the new unparsable sentences are expanded.
+	KnownTokensFilter minerFilter(miner, parsableHashAutomaton,
+		unparsableHashAutomaton);
+	readBatch(parsableFilename, unparsableFilename, &minerFilter);
+
+	if (programOptions.verbose())
+		cerr << "Number of forms after expansion: " << miner->nForms() <<
+			endl << "Mining";
+
+	miner->update(programOptions.threshold(), programOptions.suspThreshold());
+
+	if (programOptions.verbose())
+		cerr << " Done!" << endl;
+}
+
+// Read batches of new sentences, and write the results after every batch.
+// Every line of the batch list contains the names of a file with parsable
+// and a file with unparsable sentences.
+void mineBatches(ProgramOptions const &programOptions, Miner *miner,
+	Expander *expander, DynamicSuffixArray *goodIndex,
+	DynamicSuffixArray *badIndex,
+	QSharedPointer<HashAutomaton> parsableHashAutomaton,
+	QSharedPointer<HashAutomaton> unparsableHashAutomaton)
+{
+	ifstream batchesFile;
+	if (programOptions.batchesFilename() != "-")
+	{
+		batchesFile.open(programOptions.batchesFilename().c_str());
+		if (!batchesFile.good())
+			throw runtime_error("Could not read '" +
+				programOptions.batchesFilename() + "'!");
+	}
+	istream &batches = programOptions.batchesFilename() == "-" ?
+		cin : batchesFile;
+
+	ResultWriter resultWriter(unparsableHashAutomaton);
+
+	size_t batchNumber = 0;
+	string line;
+	while (getline(batches, line))
+	{
+		istringstream lineStream(line);
+		vector<string> filenames((istream_iterator<string>(lineStream)),
+			istream_iterator<string>());
+		if (filenames.empty())
+			continue;
+		if (filenames.size() != 2)
+			throw runtime_error("Invalid batch: " + line);
+
+		++batchNumber;
+		if (programOptions.verbose())
+			cerr << "Adding batch " << batchNumber << "..." << endl;
+
+		addBatch(programOptions, filenames[0], filenames[1], miner, expander,
+			goodIndex, badIndex, parsableHashAutomaton, unparsableHashAutomaton);
+
+		vector<Form const *> forms = miner->suspiciousForms(
+			programOptions.frequency(), programOptions.suspFrequency(),
+			programOptions.topK());
+
+		ostringstream resultsFilename;
+		resultsFilename << programOptions.binaryResultsFilename() << "." <<
+			batchNumber;
+		resultWriter.writeBinary(forms, resultsFilename.str());
+
+		cout << resultsFilename.str() << "\t" << forms.size() << endl;
+	}
+}
+
+struct SweepResult
+{
+	SweepResult() : nForms(0) {}
+
+	string filename;
+	size_t nForms;
+	string error;
+};
+
+// Mine a copy of an expanded miner with the parameters of a configuration,
+// and write the results.
+class MineConfig
+{
+public:
+	typedef SweepResult result_type;
+
+	MineConfig(Miner const *expanded, ProgramOptions const *programOptions,
+		ResultWriter const *resultWriter, MinerEvaluator const *evaluator,
+		QMutex *writeMutex) :
+		d_expanded(expanded), d_programOptions(programOptions),
+		d_resultWriter(resultWriter), d_evaluator(evaluator),
+		d_writeMutex(writeMutex) {}
+	SweepResult operator()(MiningConfig const &config) const;
+private:
+	Miner const *d_expanded;
+	ProgramOptions const *d_programOptions;
+	ResultWriter const *d_resultWriter;
+	MinerEvaluator const *d_evaluator;
+	QMutex *d_writeMutex;
+};
+
+SweepResult MineConfig::operator()(MiningConfig const &config) const
+{
+	SweepResult result;
+	result.filename = d_programOptions->binaryResultsFilename() + "." +
+		config.name();
+
+	// Exceptions can not cross the thread boundary, so they are reported
+	// through the result.
+	try {
+		Miner miner(*d_expanded);
+		miner.setSmoothing(config.smoothing, config.smoothingBeta);
+		miner.mine(config.threshold, config.suspThreshold);
+
+		vector<Form const *> forms = miner.suspiciousForms(
+			d_programOptions->frequency(), d_programOptions->suspFrequency(),
+			d_programOptions->topK());
+		result.nForms = forms.size();
+
+		// The hash automata that are used to decode forms are not
+		// thread-safe.
+		MinerEvaluator::Ngrams parsableNgrams;
+		{
+			QMutexLocker locker(d_writeMutex);
+			d_resultWriter->writeBinary(forms, result.filename);
+			if (d_evaluator != 0)
+				parsableNgrams = d_evaluator->parsableNgrams(forms);
+		}
+
+		if (d_evaluator != 0)
+			result.error = evaluateRanking(d_evaluator, &miner, &forms,
+				&parsableNgrams, d_programOptions->evaluationFilename() + "." +
+				config.name());
+	} catch (runtime_error const &e) {
+		result.error = e.what();
+	}
+
+	return result;
+}
+
+void sweep(ProgramOptions const &programOptions,
+		QSharedPointer<HashAutomaton> parsableHashAutomaton,
+		QSharedPointer<HashAutomaton> unparsableHashAutomaton)
+{
+	SweepGrid grid(programOptions.sweepGrid(), programOptions);
+
+	// The suffix arrays do not depend on the configuration, so they are
+	// shared by all expansions.
+	SuffixArrayPtr goodSuffixArray;
+	SuffixArrayPtr badSuffixArray;
+	QSharedPointer<HashedCorpus> hashedCorpus = createSuffixArrays(
+		programOptions, parsableHashAutomaton, unparsableHashAutomaton,
+		&goodSuffixArray, &badSuffixArray);
+
+	ResultWriter resultWriter(unparsableHashAutomaton);
+	QMutex writeMutex;
+
+	QSharedPointer<MinerEvaluator> evaluator;
+	if (!programOptions.evaluationFilename().empty())
+		evaluator = QSharedPointer<MinerEvaluator>(new MinerEvaluator(
+			parsableHashAutomaton, unparsableHashAutomaton, hashedCorpus,
+			goodSuffixArray));
+
+	bool failed = false;
+	for (vector<SweepGrid::Configs>::const_iterator groupIter =
+			grid.groups().begin(); groupIter != grid.groups().end(); ++groupIter)
+	{
+		// Expand once for all configurations in the group.
+		ExpanderPtr expander = createExpander(groupIter->front(),
+			parsableHashAutomaton, unparsableHashAutomaton, goodSuffixArray,
+			badSuffixArray);
+		Miner expanded(parsableHashAutomaton, unparsableHashAutomaton, expander);
+		readSentences(programOptions, &expanded);
+
+		if (programOptions.verbose())
+			cerr << "Number of forms after expansion: " << expanded.nForms() <<
+				endl << "Mining " << groupIter->size() << " configuration(s)... ";
+
+		// Each fixed point is computed on a private copy of the expanded
+		// miner, so configurations can be mined in parallel.
+		QFuture<SweepResult> results = QtConcurrent::mapped(*groupIter,
+			MineConfig(&expanded, &programOptions, &resultWriter,
+				evaluator.data(), &writeMutex));
+		results.waitForFinished();
+
+		if (programOptions.verbose())
+			cerr << "Done!" << endl;
+
+		for (size_t i = 0; i < groupIter->size(); ++i)
+		{
+			SweepResult result = results.resultAt(i);
+			if (result.error.empty())
+				cout << result.filename << "\t" << result.nForms << endl;
+			else
+			{
+				cerr << result.filename << ": " << result.error << endl;
+				failed = true;
+			}
+		}
+	}
+
+	if (failed)
+		throw runtime_error("Not all configurations could be mined");
+}
+
 int main(int argc, char *argv[])
 {
 	QSharedPointer<ProgramOptions> programOptions;
@@ -90,7 +543,8 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
-	if (programOptions->arguments().size() != 4)
+	if (programOptions->arguments().size() != 4 &&
+		!(programOptions->resume() && programOptions->arguments().size() == 2))
 	{
 		usage(programOptions->programName());
 		return 1;
@@ -109,97 +563,160 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
-	// Read the corpus as a sequence of hash codes.
-	if (programOptions->verbose())
-		cerr << "Reading and hashing the corpus... ";
-	QSharedPointer<HashedCorpus> hashedCorpus = readHashedCorpus(*programOptions,
-			parsableHashAutomaton, unparsableHashAutomaton);
-	if (programOptions->verbose())
-		cerr << "Done!" << endl << "Creating suffix arrays... ";
+	try {
+		if (!programOptions->sweepGrid().empty())
+		{
+			sweep(*programOptions, parsableHashAutomaton, unparsableHashAutomaton);
+			return 0;
+		}
 
-	// Store the corpora as suffix arrays.
-	QSharedPointer<SuffixArray<int> >
-		goodSuffixArray(new SuffixArray<int>(
-				hashedCorpus->good(), programOptions->sortAlgorithm()));
-	QSharedPointer<SuffixArray<int> >
-		badSuffixArray(new SuffixArray<int>(
-				hashedCorpus->bad(), programOptions->sortAlgorithm()));
-
-	if (programOptions->verbose())
-		cerr << "Done!" << endl;
+		// When resuming from a checkpoint, the corpus is not read again, so
+		// the miner does not need an expander.
+		ExpanderPtr expander;
+		QSharedPointer<TagExpander> tagExpander;
+		DynamicSuffixArrayPtr goodIndex;
+		DynamicSuffixArrayPtr badIndex;
+		QSharedPointer<MinerEvaluator> evaluator;
+		if (programOptions->tagExpansion())
+		{
+			// The tagged corpora replace the suffix arrays of the hashed
+			// corpora.
+			tagExpander = createTagExpander(*programOptions,
+				parsableHashAutomaton, unparsableHashAutomaton);
+			expander = tagExpander;
+		}
+		else if (!programOptions->resume())
+		{
+			SuffixArrayPtr goodSuffixArray;
+			SuffixArrayPtr badSuffixArray;
+			QSharedPointer<HashedCorpus> hashedCorpus = createSuffixArrays(
+				*programOptions, parsableHashAutomaton, unparsableHashAutomaton,
+				&goodSuffixArray, &badSuffixArray);
+
+			if (!programOptions->evaluationFilename().empty())
+				evaluator = QSharedPointer<MinerEvaluator>(new MinerEvaluator(
+					parsableHashAutomaton, unparsableHashAutomaton, hashedCorpus,
+					goodSuffixArray));
+
+			// Batches of new sentences are added to the suffix arrays in
+			// incremental mode. Otherwise, the expander uses the suffix
+			// arrays directly.
+			if (!programOptions->batchesFilename().empty())
+			{
+				goodIndex = DynamicSuffixArrayPtr(new DynamicSuffixArray(goodSuffixArray));
+				badIndex = DynamicSuffixArrayPtr(new DynamicSuffixArray(badSuffixArray));
+				expander = createExpander(defaultConfig(*programOptions),
+					parsableHashAutomaton, unparsableHashAutomaton, goodIndex,
+					badIndex);
+			}
+			else
+				expander = createExpander(defaultConfig(*programOptions),
+					parsableHashAutomaton, unparsableHashAutomaton, goodSuffixArray,
+					badSuffixArray);
+		}
 
-	// Construct a sentence reader.
-	TokenizedSentenceReader reader;
+		// Create a miner.
+		Miner miner(parsableHashAutomaton, unparsableHashAutomaton,
+				expander, programOptions->smoothing(), programOptions->smoothingBeta());
 
-    QSharedPointer<Expander> expander;
-    if (programOptions->ngramExpansion())
-        expander = QSharedPointer<Expander>(new BestRatioExpander(parsableHashAutomaton,
-            unparsableHashAutomaton, goodSuffixArray, badSuffixArray, programOptions->n(),
-            programOptions->expansionFactorAlpha()));
-    else
-        expander = QSharedPointer<Expander>(new SimpleExpander(parsableHashAutomaton,
-            unparsableHashAutomaton, goodSuffixArray, badSuffixArray, programOptions->n(),
-            programOptions->m()));
-    
-	// Create a miner, and register it as a handler for the sentence reader.
-	Miner miner(parsableHashAutomaton, unparsableHashAutomaton,
-            expander, programOptions->smoothing(), programOptions->smoothingBeta());
-	reader.addHandler(&miner);
-
-	// Observe the mining process, if we want verbose output.
-	QSharedPointer<CycleNotifier> cycleNotifier;
-	if (programOptions->verbose()) {
-		cycleNotifier = QSharedPointer<CycleNotifier>(new CycleNotifier());
-		miner.attach(cycleNotifier.data());
-	}
+		// Observe the mining process, if we want verbose output.
+		QSharedPointer<CycleNotifier> cycleNotifier;
+		if (programOptions->verbose()) {
+			cycleNotifier = QSharedPointer<CycleNotifier>(new CycleNotifier());
+			miner.attach(cycleNotifier.data());
+		}
 
-	ifstream badIn(programOptions->arguments()[3].c_str());
-	if (!badIn.good())
-	{
-		cout << "Could not read '" << programOptions->arguments()[3] <<
-			"'!" << endl;
-		return 1;
-	}
+		if (!programOptions->checkpointFilename().empty())
+			miner.setCheckpoint(programOptions->checkpointFilename(),
+				programOptions->checkpointInterval());
 
-	ifstream goodIn(programOptions->arguments()[2].c_str());
-	if (!goodIn.good()) {
-		cout << "Could not read '" << programOptions->arguments()[2] << "'!" << endl;
-		return 1;
-	}
+		if (programOptions->resume())
+		{
+			if (programOptions->verbose())
+				cerr << "Reading checkpoint... ";
 
-	if (programOptions->verbose())
-		cerr << "Reading parsable and unparsable sentences... ";
+			miner.readCheckpoint(programOptions->checkpointFilename());
 
-	reader.read(goodIn, badIn);
+			if (programOptions->verbose())
+				cerr << "Done!" << endl << "Mining";
 
-	if (programOptions->verbose())
-		cerr << "Done!" << endl;
+			// Continue mining from the checkpoint.
+			miner.resume(programOptions->threshold(),
+				programOptions->suspThreshold());
+		}
+		else
+		{
+			readSentences(*programOptions, &miner);
 
-	if (programOptions->verbose()) {
-		std::set<Form, FormProbComp> forms = miner.forms();
-		cerr << "Number of forms after expansion: " << forms.size() << endl;
-		cerr << "Mining";
-	}
+			if (programOptions->verbose()) {
+				cerr << "Number of forms after expansion: " << miner.nForms() << endl;
+				cerr << "Mining";
+			}
 
-	// Start mining.
-	miner.mine(programOptions->threshold(), programOptions->suspThreshold());
+			// Start mining.
+			miner.mine(programOptions->threshold(),
+				programOptions->suspThreshold());
+		}
 
-	if (programOptions->verbose())
-		cerr << " Done!" << endl;
+		if (programOptions->verbose())
+			cerr << " Done!" << endl;
+
+		// Retrieve forms with the proper frequencies, ordered by descending
+		// suspicion.
+		vector<Form const *> forms = miner.suspiciousForms(
+			programOptions->frequency(), programOptions->suspFrequency(),
+			programOptions->topK());
+
+		// The evaluation runs while the results are written. The n-grams
+		// are converted first, since the result writer uses the hash
+		// automata as well.
+		MinerEvaluator::Ngrams parsableNgrams;
+		QFuture<string> evaluation;
+		if (!evaluator.isNull())
+		{
+			parsableNgrams = evaluator->parsableNgrams(forms);
+			evaluation = QtConcurrent::run(evaluateRanking,
+				static_cast<MinerEvaluator const *>(evaluator.data()),
+				static_cast<Miner const *>(&miner),
+				static_cast<vector<Form const *> const *>(&forms),
+				static_cast<MinerEvaluator::Ngrams const *>(&parsableNgrams),
+				programOptions->evaluationFilename());
+		}
 
-	// Retrieve forms, ordered by descending suspicion.
-	set<Form, FormProbComp> forms = miner.forms();
+		// In incremental mode, the results of every batch are written to
+		// a separate file.
+		string resultsFilename = programOptions->binaryResultsFilename();
+		if (!programOptions->batchesFilename().empty())
+			resultsFilename += ".0";
+
+		ResultWriter resultWriter(unparsableHashAutomaton);
+		resultWriter.setTagExpander(tagExpander);
+		try {
+			if (resultsFilename.empty())
+				resultWriter.write(forms);
+			else
+				resultWriter.writeBinary(forms, resultsFilename);
+		} catch (runtime_error const &) {
+			// The evaluation uses the forms and the miner.
+			evaluation.waitForFinished();
+			throw;
+		}
 
-	// Print forms with the proper frequencies.
-	for (set<Form>::const_iterator formIter = forms.begin();
-			formIter != forms.end(); ++formIter)
-		if (formIter->nObservations() >= programOptions->frequency() &&
-				formIter->nSuspObservations() >= programOptions->suspFrequency())
+		if (!evaluator.isNull())
 		{
-			transform(formIter->ngram().begin(), formIter->ngram().end(),
-					ostream_iterator<string>(cout, " "), *unparsableHashAutomaton);
-			cout << formIter->suspicion() << " " <<
-				formIter->nObservations() << " " << formIter->nSuspObservations() <<
-				endl;
+			string error = evaluation.result();
+			if (!error.empty())
+				throw runtime_error(error);
 		}
+
+		if (!programOptions->batchesFilename().empty())
+		{
+			cout << resultsFilename << "\t" << forms.size() << endl;
+			mineBatches(*programOptions, &miner, expander.data(), goodIndex.data(),
+				badIndex.data(), parsableHashAutomaton, unparsableHashAutomaton);
+		}
+	} catch (runtime_error const &e) {
+		cerr << e.what() << endl;
+		return 1;
+	}
 }
@@ -5,11 +5,14 @@ TARGET = ../bin/mine
 CONFIG += qt debug_and_release warn_on
 QT = core
 
-SOURCES += mine.cpp ProgramOptions.cpp
-HEADERS += ProgramOptions.hh
+SOURCES += mine.cpp KnownTokensFilter.cpp MinerEvaluator.cpp ProgramOptions.cpp \
+	ResultWriter.cpp SweepGrid.cpp
+HEADERS += KnownTokensFilter.hh MinerEvaluator.hh ProgramOptions.hh \
+	ResultWriter.hh SweepGrid.hh
 
 # Internal headers
-HEADERS += ProgramOptions.ih
+HEADERS += KnownTokensFilter.ih MinerEvaluator.ih ProgramOptions.ih \
+	ResultWriter.ih SweepGrid.ih
 
 mac {
         CONFIG -= app_bundle
@@ -0,0 +1,52 @@
+#include "MiningServer.ih"
+
+/**
+ * A client connection. Requests are read and answered in sequence, until
+ * the client disconnects.
+ */
+class MiningServer::Connection : public QThread
+{
+public:
+	Connection(quintptr socketDescriptor,
+			QSharedPointer<MiningService> service) :
+		d_socketDescriptor(socketDescriptor), d_service(service) {}
+protected:
+	void run();
+private:
+	quintptr d_socketDescriptor;
+	QSharedPointer<MiningService> d_service;
+};
+
+void MiningServer::Connection::run()
+{
+	// The socket is created in this thread, since it can only be used
+	// from the thread that owns it.
+	QLocalSocket socket;
+	if (!socket.setSocketDescriptor(d_socketDescriptor))
+		return;
+
+	while (socket.state() == QLocalSocket::ConnectedState)
+	{
+		if (!socket.canReadLine() && !socket.waitForReadyRead(-1))
+			break;
+
+		while (socket.canReadLine())
+		{
+			socket.write(d_service->handle(socket.readLine()));
+			socket.waitForBytesWritten(-1);
+		}
+	}
+
+	if (socket.state() != QLocalSocket::UnconnectedState)
+	{
+		socket.disconnectFromServer();
+		socket.waitForDisconnected();
+	}
+}
+
+void MiningServer::incomingConnection(quintptr socketDescriptor)
+{
+	Connection *connection = new Connection(socketDescriptor, d_service);
+	connect(connection, SIGNAL(finished()), connection, SLOT(deleteLater()));
+	connection->start();
+}
@@ -0,0 +1,31 @@
+#ifndef MINING_SERVER_HH_
+#define MINING_SERVER_HH_
+
+#include <QLocalServer>
+#include <QObject>
+#include <QSharedPointer>
+
+#include "MiningService.hh"
+
+/**
+ * A local socket server that answers requests using a mining service.
+ * Each connection is handled in its own thread, so that a long-running
+ * request (such as re-mining) does not block other clients.
+ */
+class MiningServer : public QLocalServer
+{
+public:
+	MiningServer(QSharedPointer<MiningService> service, QObject *parent = 0) :
+		QLocalServer(parent), d_service(service) {}
+protected:
+	void incomingConnection(quintptr socketDescriptor);
+private:
+	class Connection;
+
+	MiningServer(MiningServer const &other);
+	MiningServer &operator=(MiningServer const &other);
+
+	QSharedPointer<MiningService> d_service;
+};
+
+#endif // MINING_SERVER_HH_
@@ -0,0 +1,217 @@
+#include "MiningService.ih"
+
+namespace {
+
+QByteArray ok(size_t nLines)
+{
+	return "ok " + QByteArray::number(static_cast<qulonglong>(nLines)) + "\n";
+}
+
+QByteArray error(QByteArray const &message)
+{
+	return "error " + message + "\n";
+}
+
+bool parseSize(QByteArray const &arg, size_t *value)
+{
+	bool valid;
+	*value = arg.toULongLong(&valid);
+	return valid;
+}
+
+}
+
+QByteArray MiningService::handle(QByteArray const &request)
+{
+	Args args = request.simplified().split(' ');
+	if (args.isEmpty() || args.first().isEmpty())
+		return error("empty request");
+
+	QByteArray command = args.takeFirst();
+
+	try {
+		if (command == "form")
+			return form(args);
+		else if (command == "top")
+			return top(args);
+		else if (command == "sentences")
+			return sentences(args);
+		else if (command == "remove")
+			return remove(args);
+		else if (command == "reset")
+			return reset();
+		else if (command == "stats")
+			return stats();
+	} catch (runtime_error const &e) {
+		return error(e.what());
+	}
+
+	return error("unknown command: " + command);
+}
+
+QByteArray MiningService::form(Args const &args) const
+{
+	QSharedPointer<MiningState const> state = this->state();
+
+	vector<int> ngram;
+	Form const *form = 0;
+	if (this->ngram(args.begin(), args.end(), &ngram))
+		form = state->miner().form(ngram);
+
+	if (form == 0)
+		return error("unknown form");
+
+	return ok(1) + formatForm(*state, form);
+}
+
+QByteArray MiningService::top(Args const &args) const
+{
+	size_t k;
+	if (args.size() != 1 || !parseSize(args.first(), &k))
+		return error("usage: top k");
+
+	QSharedPointer<MiningState const> state = this->state();
+	MiningState::Forms const &ranking = state->ranking();
+	k = min(k, ranking.size());
+
+	QByteArray response = ok(k);
+	for (size_t i = 0; i < k; ++i)
+		response += formatForm(*state, ranking[i]);
+
+	return response;
+}
+
+QByteArray MiningService::sentences(Args const &args) const
+{
+	size_t k;
+	if (args.size() < 2 || !parseSize(args.first(), &k))
+		return error("usage: sentences k w1 w2 ...");
+
+	QSharedPointer<MiningState const> state = this->state();
+
+	vector<int> ngram;
+	Form const *form = 0;
+	if (this->ngram(args.begin() + 1, args.end(), &ngram))
+		form = state->miner().form(ngram);
+
+	if (form == 0)
+		return error("unknown form");
+
+	vector<quint32> sentences = state->sentences(form);
+	if (k == 0 || k > sentences.size())
+		k = sentences.size();
+
+	QByteArray response = ok(k);
+	for (size_t i = 0; i < k; ++i)
+	{
+		string const &sentence = (*d_sentences)[sentences[i]];
+		response += QByteArray::number(static_cast<qulonglong>(sentences[i])) +
+			"\t" + QByteArray(sentence.data(), sentence.size()) + "\n";
+	}
+
+	return response;
+}
+
+QByteArray MiningService::remove(Args const &args)
+{
+	// Split the arguments into forms.
+	MiningState::Ngrams ngrams;
+	Args::const_iterator begin = args.begin();
+	for (Args::const_iterator iter = args.begin(); ; ++iter)
+		if (iter == args.end() || *iter == "|")
+		{
+			vector<int> ngram;
+			if (begin != iter && this->ngram(begin, iter, &ngram))
+				ngrams.push_back(ngram);
+			if (iter == args.end())
+				break;
+			begin = iter + 1;
+		}
+
+	if (ngrams.empty())
+		return error("no known forms to remove");
+
+	// Only one re-mining run at a time, so that removals accumulate.
+	QMutexLocker mineLocker(&d_mineMutex);
+	QSharedPointer<MiningState const> current = state();
+
+	QSharedPointer<Miner> miner(new Miner(current->miner()));
+	size_t nRemoved = miner->removeForms(ngrams);
+	if (nRemoved == 0)
+		return error("no known forms to remove");
+
+	miner->mine(d_threshold, d_suspThreshold);
+
+	MiningState::Ngrams removed(current->removed());
+	removed.insert(removed.end(), ngrams.begin(), ngrams.end());
+	setState(QSharedPointer<MiningState const>(new MiningState(miner,
+		d_minFreq, d_minSuspFreq, removed)));
+
+	return ok(1) + "removed\t" +
+		QByteArray::number(static_cast<qulonglong>(nRemoved)) + "\n";
+}
+
+QByteArray MiningService::reset()
+{
+	QMutexLocker mineLocker(&d_mineMutex);
+	setState(d_initial);
+	return ok(0);
+}
+
+QByteArray MiningService::stats() const
+{
+	QSharedPointer<MiningState const> state = this->state();
+
+	QByteArray response = ok(4);
+	response += "forms\t" + QByteArray::number(
+		static_cast<qulonglong>(state->miner().nForms())) + "\n";
+	response += "ranked\t" + QByteArray::number(
+		static_cast<qulonglong>(state->ranking().size())) + "\n";
+	response += "sentences\t" + QByteArray::number(
+		static_cast<qulonglong>(state->miner().sentences().size())) + "\n";
+	response += "removed\t" + QByteArray::number(
+		static_cast<qulonglong>(state->removed().size())) + "\n";
+	return response;
+}
+
+bool MiningService::ngram(Args::const_iterator begin, Args::const_iterator end,
+	vector<int> *ngram) const
+{
+	ngram->clear();
+	for (Args::const_iterator iter = begin; iter != end; ++iter)
+	{
+		int id = d_vocabulary->id(*iter);
+		if (id == -1)
+			return false;
+		ngram->push_back(id);
+	}
+
+	return !ngram->empty();
+}
+
+QByteArray MiningService::formatForm(MiningState const &state,
+	Form const *form) const
+{
+	// %g gives the same representation as the text results of mine.
+	char suspicion[32];
+	snprintf(suspicion, sizeof(suspicion), "%g", form->suspicion());
+
+	return d_vocabulary->ngram(form->ngram()) + "\t" +
+		QByteArray::number(static_cast<qulonglong>(state.rank(form))) + "\t" +
+		suspicion + "\t" +
+		QByteArray::number(static_cast<qulonglong>(form->nObservations())) + "\t" +
+		QByteArray::number(static_cast<qulonglong>(form->nSuspObservations())) +
+		"\n";
+}
+
+QSharedPointer<MiningState const> MiningService::state() const
+{
+	QMutexLocker locker(&d_stateMutex);
+	return d_state;
+}
+
+void MiningService::setState(QSharedPointer<MiningState const> state)
+{
+	QMutexLocker locker(&d_stateMutex);
+	d_state = state;
+}
@@ -0,0 +1,110 @@
+#ifndef MINING_SERVICE_HH_
+#define MINING_SERVICE_HH_
+
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+
+#include "MiningState.hh"
+#include "Vocabulary.hh"
+
+/**
+ * Answers queries about a mined data set. Every request is a single
+ * line, with a command and its arguments separated by spaces:
+ *
+ * <ul>
+ * <li><i>form w1 w2 ...</i>: the rank, suspicion, frequency and
+ *  unparsable frequency of a form.</li>
+ * <li><i>top k</i>: the k most suspicious forms.</li>
+ * <li><i>sentences k w1 w2 ...</i>: at most k unparsable sentences in
+ *  which the form was observed, 0 gives all sentences.</li>
+ * <li><i>remove w1 w2 ... | w3 ...</i>: remove forms, separated by '|',
+ *  and mine again.</li>
+ * <li><i>reset</i>: return to the initial mining results.</li>
+ * <li><i>stats</i>: the number of forms, ranked forms, sentences and
+ *  removed forms.</li>
+ * </ul>
+ *
+ * The response starts with a line "ok n", followed by n lines with
+ * tab-separated fields, or consists of a line "error message".
+ *
+ * Queries are answered from an immutable snapshot, so they can be
+ * handled concurrently. Re-mining is performed on a copy of the current
+ * snapshot, which replaces it when mining is finished. Queries that
+ * arrive in the meantime are answered from the old snapshot.
+ */
+class MiningService
+{
+public:
+	/**
+	 * Construct a service.
+	 *
+	 * @param initial The initial mining results.
+	 * @param vocabulary The vocabulary of the forms.
+	 * @param sentences The text of the unparsable sentences, in the order
+	 *  of the sentences of the miner.
+	 * @param threshold The mining threshold for re-mining.
+	 * @param suspThreshold The suspicion threshold for re-mining.
+	 * @param minFreq The minimum frequency of ranked forms.
+	 * @param minSuspFreq The minimum unparsable frequency of ranked forms.
+	 */
+	MiningService(QSharedPointer<MiningState const> initial,
+		QSharedPointer<Vocabulary const> vocabulary,
+		QSharedPointer<std::vector<std::string> const> sentences,
+		double threshold, double suspThreshold, size_t minFreq,
+		size_t minSuspFreq) :
+		d_initial(initial), d_state(initial), d_vocabulary(vocabulary),
+		d_sentences(sentences), d_threshold(threshold),
+		d_suspThreshold(suspThreshold), d_minFreq(minFreq),
+		d_minSuspFreq(minSuspFreq) {}
+
+	/**
+	 * Handle a request, and return the response. This method can be
+	 * called from multiple threads.
+	 */
+	QByteArray handle(QByteArray const &request);
+private:
+	typedef QList<QByteArray> Args;
+
+	MiningService(MiningService const &other);
+	MiningService &operator=(MiningService const &other);
+
+	QByteArray form(Args const &args) const;
+	QByteArray top(Args const &args) const;
+	QByteArray sentences(Args const &args) const;
+	QByteArray remove(Args const &args);
+	QByteArray reset();
+	QByteArray stats() const;
+
+	// Convert words to an n-gram, returns false if a word is unknown.
+	bool ngram(Args::const_iterator begin, Args::const_iterator end,
+		std::vector<int> *ngram) const;
+
+	// Format a form as tab-separated fields.
+	QByteArray formatForm(MiningState const &state,
+		errormining::Form const *form) const;
+
+	QSharedPointer<MiningState const> state() const;
+	void setState(QSharedPointer<MiningState const> state);
+
+	QSharedPointer<MiningState const> d_initial;
+	QSharedPointer<MiningState const> d_state;
+	QSharedPointer<Vocabulary const> d_vocabulary;
+	QSharedPointer<std::vector<std::string> const> d_sentences;
+	double d_threshold;
+	double d_suspThreshold;
+	size_t d_minFreq;
+	size_t d_minSuspFreq;
+
+	// Guards d_state.
+	mutable QMutex d_stateMutex;
+
+	// Serializes re-mining.
+	QMutex d_mineMutex;
+};
+
+#endif // MINING_SERVICE_HH_
@@ -0,0 +1,48 @@
+#include "MiningState.ih"
+
+MiningState::MiningState(QSharedPointer<Miner> miner, size_t minFreq,
+		size_t minSuspFreq, Ngrams const &removed) :
+	d_miner(miner), d_removed(removed)
+{
+	d_ranking = d_miner->suspiciousForms(minFreq, minSuspFreq);
+	d_ranks.reserve(d_ranking.size());
+	for (size_t i = 0; i < d_ranking.size(); ++i)
+		d_ranks.insert(d_ranking[i], i + 1);
+
+	// Number all forms, including the forms that are not ranked, and
+	// link them to the sentences in which they were observed.
+	vector<FormSentenceIncidence::Link> links;
+	list<Sentence> const &sentences = d_miner->sentences();
+	quint32 sentence = 0;
+	for (list<Sentence>::const_iterator sentenceIter = sentences.begin();
+			sentenceIter != sentences.end(); ++sentenceIter, ++sentence)
+		for (Sentence::const_iterator formIter = sentenceIter->begin();
+				formIter != sentenceIter->end(); ++formIter)
+		{
+			QHash<Form const *, quint32>::const_iterator idIter =
+				d_formIds.find(*formIter);
+			if (idIter == d_formIds.end())
+				idIter = d_formIds.insert(*formIter, d_formIds.size());
+			links.push_back(make_pair(idIter.value(), sentence));
+		}
+
+	// All sentences of the miner are unparsable.
+	d_incidence = QSharedPointer<FormSentenceIncidence>(
+		new FormSentenceIncidence(links, vector<bool>(sentences.size(), true)));
+}
+
+vector<quint32> MiningState::sentences(Form const *form) const
+{
+	QHash<Form const *, quint32>::const_iterator idIter = d_formIds.find(form);
+	if (idIter == d_formIds.end())
+		return vector<quint32>();
+
+	vector<quint32> sentences(d_incidence->sentencesBegin(idIter.value()),
+		d_incidence->sentencesEnd(idIter.value()));
+
+	// A form can be observed more than once in a sentence.
+	sort(sentences.begin(), sentences.end());
+	sentences.erase(unique(sentences.begin(), sentences.end()), sentences.end());
+
+	return sentences;
+}
@@ -0,0 +1,98 @@
+#ifndef MINING_STATE_HH_
+#define MINING_STATE_HH_
+
+#include <vector>
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QtGlobal>
+
+#include <errormining/Form.hh>
+#include <errormining/FormSentenceIncidence.hh>
+#include <errormining/Miner.hh>
+
+/**
+ * An immutable snapshot of a mined data set that queries are answered
+ * from: the miner, the forms ordered by suspicion, and the unparsable
+ * sentences in which every form was observed. Since a snapshot is never
+ * modified, it can be queried from multiple threads.
+ */
+class MiningState
+{
+public:
+	typedef std::vector<errormining::Form const *> Forms;
+	typedef std::vector<std::vector<int> > Ngrams;
+
+	/**
+	 * Construct a snapshot.
+	 *
+	 * @param miner The mined miner, the snapshot takes ownership.
+	 * @param minFreq The minimum frequency of ranked forms.
+	 * @param minSuspFreq The minimum frequency in unparsable sentences of
+	 *  ranked forms.
+	 * @param removed The n-grams of the forms that were removed before
+	 *  mining.
+	 */
+	MiningState(QSharedPointer<errormining::Miner> miner, size_t minFreq,
+		size_t minSuspFreq, Ngrams const &removed = Ngrams());
+
+	/**
+	 * Return the miner.
+	 */
+	errormining::Miner const &miner() const;
+
+	/**
+	 * Return the forms that satisfy the frequency thresholds, ordered by
+	 * descending suspicion.
+	 */
+	Forms const &ranking() const;
+
+	/**
+	 * Return the rank of a form (starting at 1), or 0 if the form is not
+	 * ranked.
+	 */
+	size_t rank(errormining::Form const *form) const;
+
+	/**
+	 * Return the n-grams of the forms that were removed.
+	 */
+	Ngrams const &removed() const;
+
+	/**
+	 * Return the numbers of the unparsable sentences in which a form
+	 * was observed, in ascending order.
+	 */
+	std::vector<quint32> sentences(errormining::Form const *form) const;
+private:
+	MiningState(MiningState const &other);
+	MiningState &operator=(MiningState const &other);
+
+	QSharedPointer<errormining::Miner> d_miner;
+	Forms d_ranking;
+	QHash<errormining::Form const *, quint32> d_formIds;
+	QHash<errormining::Form const *, quint32> d_ranks;
+	QSharedPointer<errormining::FormSentenceIncidence> d_incidence;
+	Ngrams d_removed;
+};
+
+inline errormining::Miner const &MiningState::miner() const
+{
+	return *d_miner;
+}
+
+inline MiningState::Forms const &MiningState::ranking() const
+{
+	return d_ranking;
+}
+
+inline size_t MiningState::rank(errormining::Form const *form) const
+{
+	return d_ranks.value(form, 0);
+}
+
+inline MiningState::Ngrams const &MiningState::removed() const
+{
+	return d_removed;
+}
+
+#endif // MINING_STATE_HH_
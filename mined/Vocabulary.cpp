@@ -0,0 +1,43 @@
+#include "Vocabulary.ih"
+
+Vocabulary::Vocabulary(HashAutomaton const &hashAutomaton, Miner const &miner)
+{
+	vector<Form const *> forms = miner.suspiciousForms();
+	for (vector<Form const *>::const_iterator formIter = forms.begin();
+			formIter != forms.end(); ++formIter)
+		for (vector<int>::const_iterator tokenIter = (*formIter)->ngram().begin();
+				tokenIter != (*formIter)->ngram().end(); ++tokenIter)
+		{
+			if (*tokenIter < 0)
+				continue;
+
+			size_t id = *tokenIter;
+			if (id >= d_words.size())
+				d_words.resize(id + 1);
+			if (d_words[id].empty())
+			{
+				d_words[id] = hashAutomaton(*tokenIter);
+				d_ids.insert(QByteArray(d_words[id].data(), d_words[id].size()),
+					*tokenIter);
+			}
+		}
+}
+
+int Vocabulary::id(QByteArray const &word) const
+{
+	return d_ids.value(word, -1);
+}
+
+QByteArray Vocabulary::ngram(vector<int> const &ngram) const
+{
+	QByteArray text;
+	for (vector<int>::const_iterator iter = ngram.begin(); iter != ngram.end();
+			++iter)
+	{
+		if (iter != ngram.begin())
+			text.append(' ');
+		if (*iter >= 0 && static_cast<size_t>(*iter) < d_words.size())
+			text.append(d_words[*iter].data(), d_words[*iter].size());
+	}
+	return text;
+}
@@ -0,0 +1,42 @@
+#ifndef VOCABULARY_HH_
+#define VOCABULARY_HH_
+
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+#include <QHash>
+
+#include <errormining/HashAutomaton.hh>
+#include <errormining/Miner.hh>
+
+/**
+ * The words of the forms of a miner. The hash automaton is not
+ * thread-safe, so all words are decoded once, and queries are answered
+ * from this table.
+ */
+class Vocabulary
+{
+public:
+	/**
+	 * Construct the vocabulary of the forms of a miner.
+	 */
+	Vocabulary(errormining::HashAutomaton const &hashAutomaton,
+		errormining::Miner const &miner);
+
+	/**
+	 * Return the identifier of a word, or -1 if the word does not occur
+	 * in any form.
+	 */
+	int id(QByteArray const &word) const;
+
+	/**
+	 * Return the n-gram of a form as a space-separated string.
+	 */
+	QByteArray ngram(std::vector<int> const &ngram) const;
+private:
+	std::vector<std::string> d_words;
+	QHash<QByteArray, int> d_ids;
+};
+
+#endif // VOCABULARY_HH_
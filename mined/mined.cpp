@@ -0,0 +1,235 @@
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+
+#include <errormining/BestRatioExpander.hh>
+#include <errormining/HashAutomaton.hh>
+#include <errormining/HashedCorpus.hh>
+#include <errormining/Miner.hh>
+#include <errormining/SimpleExpander.hh>
+#include <errormining/SuffixArray.hh>
+#include <errormining/TokenizedSentenceReader.hh>
+
+#include "MiningServer.hh"
+#include "MiningService.hh"
+#include "MiningState.hh"
+#include "ProgramOptions.hh"
+#include "Vocabulary.hh"
+
+using namespace std;
+using namespace errormining;
+
+void usage(string const &programName)
+{
+		cerr << "Usage: " << programName <<
+			" [OPTION]... socket parsable_fsa unparsable_fsa parsable unparsable" <<
+			endl << endl <<
+			"  -b val\tEnable smoothing, and set beta to val" << endl <<
+			"  -c\t\tDisable ngram expansion" << endl <<
+			"  -e val\tEnable use of an expansion factor, and set alpha to val" << endl <<
+			"  -f freq\tRank forms observed >= freq" << endl <<
+			"  -n n\t\tUse ngrams of length n" << endl <<
+			"  -m m\t\tCreate ngrams upto length m (only used with -c)" << endl <<
+			"  -o alg\tSort algorithm (stlsort or ssort, default: ssort)" << endl <<
+			"  -p file\tRead the mining state from file if it exists, otherwise" << endl <<
+			"\t\tmine and write the mining state to file" << endl <<
+			"  -q\t\tBe quiet" << endl <<
+			"  -s t\t\tSuspicion threshold for excluding suspicious observations" << endl <<
+			"  -t t\t\tThreshold for determining the fixed-point" << endl <<
+			"  -u freq\tRank forms observed >= freq in unparsable sentences" << endl <<
+			endl;
+}
+
+QSharedPointer<Miner> mine(ProgramOptions const &programOptions,
+		QSharedPointer<HashAutomaton> parsableHashAutomaton,
+		QSharedPointer<HashAutomaton> unparsableHashAutomaton)
+{
+	string const &parsableFilename = programOptions.arguments()[3];
+	string const &unparsableFilename = programOptions.arguments()[4];
+
+	if (programOptions.verbose())
+		cerr << "Reading and hashing the corpus... ";
+
+	QSharedPointer<HashedCorpus> hashedCorpus(new HashedCorpus(
+		parsableHashAutomaton, unparsableHashAutomaton));
+	{
+		ifstream badIn(unparsableFilename.c_str());
+		if (!badIn.good())
+			throw runtime_error("Could not read " + unparsableFilename);
+
+		ifstream goodIn(parsableFilename.c_str());
+		if (!goodIn.good())
+			throw runtime_error("Could not read " + parsableFilename);
+
+		TokenizedSentenceReader reader;
+		reader.addHandler(hashedCorpus.data());
+		reader.read(goodIn, badIn);
+	}
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl << "Creating suffix arrays... ";
+
+	SuffixArrayPtr goodSuffixArray(new SuffixArray<int>(hashedCorpus->good(),
+		programOptions.sortAlgorithm()));
+	SuffixArrayPtr badSuffixArray(new SuffixArray<int>(hashedCorpus->bad(),
+		programOptions.sortAlgorithm()));
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl << "Reading parsable and unparsable sentences... ";
+
+	ExpanderPtr expander;
+	if (programOptions.ngramExpansion())
+		expander = ExpanderPtr(new BestRatioExpander(parsableHashAutomaton,
+			unparsableHashAutomaton, goodSuffixArray, badSuffixArray,
+			programOptions.n(), programOptions.expansionFactorAlpha()));
+	else
+		expander = ExpanderPtr(new SimpleExpander(parsableHashAutomaton,
+			unparsableHashAutomaton, goodSuffixArray, badSuffixArray,
+			programOptions.n(), programOptions.m()));
+
+	QSharedPointer<Miner> miner(new Miner(parsableHashAutomaton,
+		unparsableHashAutomaton, expander, programOptions.smoothing(),
+		programOptions.smoothingBeta()));
+	{
+		ifstream badIn(unparsableFilename.c_str());
+		ifstream goodIn(parsableFilename.c_str());
+
+		TokenizedSentenceReader reader;
+		reader.addHandler(miner.data());
+		reader.read(goodIn, badIn);
+	}
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl << "Mining... ";
+
+	miner->mine(programOptions.threshold(), programOptions.suspThreshold());
+
+	if (programOptions.verbose())
+		cerr << "Done!" << endl;
+
+	return miner;
+}
+
+// Read the text of the unparsable sentences, to be able to show the
+// sentences in which a form occurs.
+QSharedPointer<vector<string> const> readSentenceTexts(string const &filename)
+{
+	ifstream in(filename.c_str());
+	if (!in.good())
+		throw runtime_error("Could not read " + filename);
+
+	QSharedPointer<vector<string> > sentences(new vector<string>());
+	string line;
+	while (getline(in, line))
+		sentences->push_back(line);
+
+	return sentences;
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	QSharedPointer<ProgramOptions> programOptions;
+	try
+	{
+		programOptions = QSharedPointer<ProgramOptions>(new ProgramOptions(argc, argv));
+	}
+	catch (string error)
+	{
+		cerr << error << endl << endl;
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (programOptions->arguments().size() != 5)
+	{
+		usage(programOptions->programName());
+		return 1;
+	}
+
+	// Read the perfect hash automaton.
+	QSharedPointer<HashAutomaton> parsableHashAutomaton;
+	QSharedPointer<HashAutomaton> unparsableHashAutomaton;
+	try {
+		parsableHashAutomaton = QSharedPointer<HashAutomaton>(
+				new HashAutomaton(programOptions->arguments()[1]));
+		unparsableHashAutomaton = QSharedPointer<HashAutomaton>(
+				new HashAutomaton(programOptions->arguments()[2]));
+	} catch (InvalidAutomatonException e) {
+		cout << e.what() << endl;
+		return 1;
+	}
+
+	QSharedPointer<MiningServer> server;
+	try {
+		string const &checkpointFilename = programOptions->checkpointFilename();
+
+		QSharedPointer<Miner> miner;
+		if (!checkpointFilename.empty() &&
+			QFile::exists(QString::fromLocal8Bit(checkpointFilename.c_str())))
+		{
+			if (programOptions->verbose())
+				cerr << "Reading checkpoint... ";
+
+			// Re-mining after the removal of forms does not require
+			// expansion, so the miner does not need an expander.
+			miner = QSharedPointer<Miner>(new Miner(parsableHashAutomaton,
+				unparsableHashAutomaton, ExpanderPtr(),
+				programOptions->smoothing(), programOptions->smoothingBeta()));
+			miner->readCheckpoint(checkpointFilename);
+
+			if (programOptions->verbose())
+				cerr << "Done!" << endl;
+		}
+		else
+		{
+			miner = mine(*programOptions, parsableHashAutomaton,
+				unparsableHashAutomaton);
+			if (!checkpointFilename.empty())
+				miner->writeCheckpoint(checkpointFilename);
+		}
+
+		QSharedPointer<vector<string> const> sentences =
+			readSentenceTexts(programOptions->arguments()[4]);
+		if (sentences->size() != miner->sentences().size())
+			throw runtime_error("The unparsable sentences do not match the mining state");
+
+		QSharedPointer<Vocabulary const> vocabulary(new Vocabulary(
+			*unparsableHashAutomaton, *miner));
+		QSharedPointer<MiningState const> state(new MiningState(miner,
+			programOptions->frequency(), programOptions->suspFrequency()));
+
+		QSharedPointer<MiningService> service(new MiningService(state,
+			vocabulary, sentences, programOptions->threshold(),
+			programOptions->suspThreshold(), programOptions->frequency(),
+			programOptions->suspFrequency()));
+
+		// Remove a socket that was left behind by a previous instance.
+		QString socketName = QString::fromLocal8Bit(
+			programOptions->arguments()[0].c_str());
+		MiningServer::removeServer(socketName);
+
+		server = QSharedPointer<MiningServer>(new MiningServer(service));
+		if (!server->listen(socketName))
+			throw runtime_error("Could not listen on " +
+				programOptions->arguments()[0] + ": " +
+				server->errorString().toLocal8Bit().constData());
+
+		if (programOptions->verbose())
+			cerr << "Listening on " <<
+				server->fullServerName().toLocal8Bit().constData() << endl;
+	} catch (runtime_error const &e) {
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return app.exec();
+}
@@ -0,0 +1,19 @@
+include('../errormining.pri')
+
+TEMPLATE = app
+TARGET = ../bin/mined
+CONFIG += qt debug_and_release warn_on
+QT = core network
+
+SOURCES += mined.cpp MiningServer.cpp MiningService.cpp MiningState.cpp \
+	ProgramOptions.cpp Vocabulary.cpp
+HEADERS += MiningServer.hh MiningService.hh MiningState.hh \
+	ProgramOptions.hh Vocabulary.hh
+
+# Internal headers
+HEADERS += MiningServer.ih MiningService.ih MiningState.ih \
+	ProgramOptions.ih Vocabulary.ih
+
+mac {
+        CONFIG -= app_bundle
+}
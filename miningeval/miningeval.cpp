@@ -1,29 +1,49 @@
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <iostream>
-#include <set>
+#include <map>
+#include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <QCoreApplication>
-#include <QSet>
+#include <QFuture>
+#include <QHash>
+#include <QList>
 #include <QSharedPointer>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QString>
 #include <QVariant>
+#include <QtConcurrentMap>
 
+#include <errormining/FormSentenceIncidence.hh>
+#include <errormining/RankingEvaluator.hh>
 #include <errormining/ScoringMethod.hh>
 
 using namespace std;
 using namespace errormining;
 
+struct FormRow
+{
+	QString form;
+	uint formId;
+	double suspicion;
+	uint freq;
+	uint suspFreq;
+	uint uniqSentsFreq;
+};
+
+typedef vector<FormRow> Forms;
+
 struct FormScore
 {
-	FormScore(QString &newForm, double newScore, size_t newSuspFreq) :
-		form(newForm), score(newScore), suspFreq(newSuspFreq) {}
+	FormScore(size_t newIndex, double newScore, size_t newSuspFreq) :
+		index(newIndex), score(newScore), suspFreq(newSuspFreq) {}
 
-	QString form;
+	size_t index;
 	double score;
 	size_t suspFreq;
 };
@@ -31,21 +51,100 @@ struct FormScore
 struct FormScoreCompare :
 	public binary_function<FormScore, FormScore, bool>
 {
-	bool operator()(FormScore const &f1, FormScore const &f2)
+	FormScoreCompare(Forms const *forms) : d_forms(forms) {}
+
+	bool operator()(FormScore const &f1, FormScore const &f2) const
 	{
 		if (f1.score == f2.score)
 		{
 			if (f1.suspFreq == f2.suspFreq)
-				return f1.form < f2.form;
+				return (*d_forms)[f1.index].form < (*d_forms)[f2.index].form;
 			else
 				return f2.suspFreq < f1.suspFreq;
 		}
 		else
 			return f2.score < f1.score;
 	}
+private:
+	Forms const *d_forms;
+};
+
+// The ranking of a scoring method, with the evaluation after every form.
+struct Curve
+{
+	vector<size_t> ranking;
+	vector<EvaluationPoint> points;
 };
 
-typedef set<FormScore, FormScoreCompare> FormScoreSet;
+// Rankings of forms, as indices in the forms, by scoring method.
+typedef map<ScoringMethod, vector<size_t> > Rankings;
+
+// Rank and evaluate the forms for a scoring method. Every scoring method
+// can be evaluated on its own thread, the forms, incidence, and rankings
+// that were read from the database are shared.
+struct EvaluateMethod
+{
+	typedef Curve result_type;
+
+	EvaluateMethod(Forms const *forms, FormSentenceIncidence const *incidence,
+			Rankings const *rankings, double beta) :
+		d_forms(forms), d_incidence(incidence), d_rankings(rankings),
+		d_beta(beta) {}
+	Curve operator()(ScoringMethod scoringMethod) const;
+private:
+	vector<size_t> rankForms(ScoringMethod scoringMethod) const;
+
+	Forms const *d_forms;
+	FormSentenceIncidence const *d_incidence;
+	Rankings const *d_rankings;
+	double d_beta;
+};
+
+Curve EvaluateMethod::operator()(ScoringMethod scoringMethod) const
+{
+	Curve curve;
+
+	Rankings::const_iterator rankingIter = d_rankings->find(scoringMethod);
+	if (rankingIter != d_rankings->end())
+		curve.ranking = rankingIter->second;
+	else
+		curve.ranking = rankForms(scoringMethod);
+
+	curve.points.reserve(curve.ranking.size());
+
+	RankingEvaluator evaluator(*d_incidence, d_beta);
+	for (vector<size_t>::const_iterator iter = curve.ranking.begin();
+			iter != curve.ranking.end(); ++iter)
+		curve.points.push_back(evaluator.add((*d_forms)[*iter].formId));
+
+	return curve;
+}
+
+// Score and rank the forms, for databases without score columns.
+vector<size_t> EvaluateMethod::rankForms(ScoringMethod scoringMethod) const
+{
+	QSharedPointer<ScoreFun> scoreFun = selectScoreFun(scoringMethod);
+
+	vector<FormScore> formScores;
+	formScores.reserve(d_forms->size());
+	for (size_t i = 0; i < d_forms->size(); ++i)
+	{
+		FormRow const &row = (*d_forms)[i];
+		double score = (*scoreFun)(row.suspicion, row.freq, row.suspFreq,
+			row.uniqSentsFreq);
+		formScores.push_back(FormScore(i, score, row.suspFreq));
+	}
+
+	sort(formScores.begin(), formScores.end(), FormScoreCompare(d_forms));
+
+	vector<size_t> ranking;
+	ranking.reserve(formScores.size());
+	for (vector<FormScore>::const_iterator iter = formScores.begin();
+			iter != formScores.end(); ++iter)
+		ranking.push_back(iter->index);
+
+	return ranking;
+}
 
 bool openDatabase(QString const &dbFilename)
 {
@@ -54,106 +153,185 @@ bool openDatabase(QString const &dbFilename)
 	return db.open();
 }
 
-ScoringMethod selectScoringMethod(string const &scoringMethod)
-{
-		if (scoringMethod == "scoring_susp")
-			return SCORING_SUSP;
-		else if (scoringMethod == "scoring_susp_obs")
-			return SCORING_SUSP_OBS;
-		else if (scoringMethod == "scoring_susp_uniqsents")
-			return SCORING_SUSP_UNIQSENTS;
-		else if (scoringMethod == "scoring_susp_ln_obs")
-			return SCORING_SUSP_LN_OBS;
-		else if (scoringMethod == "scoring_susp_ln_uniqsents")
-			return SCORING_SUSP_LN_UNIQSENTS;
-        else if (scoringMethod == "scoring_susp_delta")
-            return SCORING_SUSP_DELTA;
-        else if (scoringMethod == "scoring_susp_ln_delta")
-            return SCORING_SUSP_LN_DELTA;
-
-		cerr << "Unknown scoring method: '" << scoringMethod <<
-			"', using 'scoring_susp'." << endl;
-
-		return SCORING_SUSP;
+// Select scoring methods: 'all', or a comma-separated list of names.
+QList<ScoringMethod> selectScoringMethods(string const &scoringMethods)
+{
+	QList<ScoringMethod> methods;
+
+	if (scoringMethods == "all")
+	{
+		for (size_t i = 0; i < N_SCORING_METHODS; ++i)
+			methods.push_back(SCORING_METHODS[i].method);
+		return methods;
+	}
+
+	istringstream methodStream(scoringMethods);
+	string name;
+	while (getline(methodStream, name, ','))
+	{
+		ScoringMethod method;
+		if (scoringMethodByName(name, &method))
+			methods.push_back(method);
+		else
+			cerr << "Unknown scoring method: '" << name <<
+				"', using 'scoring_susp'." << endl;
+	}
+
+	if (methods.isEmpty())
+		methods.push_back(SCORING_SUSP);
+
+	return methods;
 }
 
-FormScoreSet scoreForms(ScoringMethod scoringMethod)
+Forms readForms()
 {
-	FormScoreSet formScores;
-	QSharedPointer<ScoreFun> scoreFun = selectScoreFun(scoringMethod);
+	Forms forms;
 
-    QSqlQuery query("SELECT form, suspicion, freq, suspFreq, uniqSentsFreq"
+    QSqlQuery query("SELECT form, suspicion, freq, suspFreq, uniqSentsFreq, rowid"
 		" FROM forms");// WHERE suspicion > 1.5 * (SELECT AVG(suspicion) FROM forms)");
 	while (query.next())
 	{
-		QString form = query.value(0).toString();
-		double suspicion = query.value(1).toDouble();
-        uint freq = query.value(2).toUInt();
-        uint suspFreq = query.value(3).toUInt();
-        uint uniqSentsFreq = query.value(4).toUInt();
-
-        double score = (*scoreFun)(suspicion, freq, suspFreq, uniqSentsFreq);
-		formScores.insert(FormScore(form, score, suspFreq));
+		FormRow row;
+		row.form = query.value(0).toString();
+		row.suspicion = query.value(1).toDouble();
+		row.freq = query.value(2).toUInt();
+		row.suspFreq = query.value(3).toUInt();
+		row.uniqSentsFreq = query.value(4).toUInt();
+		row.formId = query.value(5).toUInt();
+		forms.push_back(row);
 	}
 
-	return formScores;
+	return forms;
 }
 
-QSet<size_t> allSentences(bool unparsable)
+// Databases created by older versions of createminedb do not have
+// precomputed scores.
+bool hasScoreColumns()
 {
-	QSet<size_t> sentenceIds;
-	
-	QSqlQuery query;
-	query.setForwardOnly(true);
-	query.prepare("SELECT sentences.rowid FROM sentences "
-		"WHERE sentences.unparsable = :unparsable");
-	query.bindValue(":unparsable", unparsable);
+	QSqlQuery query("SELECT 1 FROM sqlite_master"
+		" WHERE type = 'table' AND name = 'statistics'");
+	return query.next();
+}
 
-	query.exec();
+// Read the rankings of the scoring methods from the database. The index
+// on a score column follows the order of FormScoreCompare, so the forms
+// are not sorted.
+Rankings readRankings(Forms const &forms, QList<ScoringMethod> const &methods)
+{
+	QHash<uint, size_t> formIndices;
+	for (size_t i = 0; i < forms.size(); ++i)
+		formIndices.insert(forms[i].formId, i);
 
-	while (query.next())
-		sentenceIds.insert(query.value(0).toUInt());
+	Rankings rankings;
+	for (QList<ScoringMethod>::const_iterator iter = methods.begin();
+			iter != methods.end(); ++iter)
+	{
+		QString column = QString::fromLatin1(
+			scoringMethodColumn(*iter).c_str());
+
+		QSqlQuery query;
+		query.setForwardOnly(true);
+		query.exec("SELECT rowid FROM forms ORDER BY " + column +
+			" DESC, suspFreq DESC, form");
+
+		vector<size_t> &ranking = rankings[*iter];
+		ranking.reserve(forms.size());
+		while (query.next())
+			ranking.push_back(formIndices.value(query.value(0).toUInt()));
+	}
 
-	return sentenceIds;
+	return rankings;
 }
 
-QSet<size_t> formSentences(QString const &form, bool unparsable)
+// Load the sentences of all forms at once, rather than querying the
+// sentences of every form in the ranking.
+FormSentenceIncidence loadIncidence()
 {
-	QSet<size_t> sentenceIds;
+	vector<bool> unparsable;
+	{
+		QSqlQuery query;
+		query.setForwardOnly(true);
+		query.exec("SELECT rowid, unparsable FROM sentences");
+		while (query.next())
+		{
+			size_t sentenceId = query.value(0).toUInt();
+			if (sentenceId >= unparsable.size())
+				unparsable.resize(sentenceId + 1, false);
+			unparsable[sentenceId] = query.value(1).toString() == "true";
+		}
+	}
 
-	QSqlQuery query;
-	query.setForwardOnly(true);
-	query.prepare("SELECT formSentence.sentenceId "
-		"FROM forms, formSentence, sentences "
-		"WHERE forms.form = :form AND forms.rowid = formSentence.formId AND "
-		"sentences.rowid = formSentence.sentenceId AND "
-		"sentences.unparsable = :unparsable");
-	query.bindValue(":form", form);
-	query.bindValue(":unparsable", unparsable);
-	
-	query.exec();
+	vector<FormSentenceIncidence::Link> links;
+	{
+		QSqlQuery query;
+		query.setForwardOnly(true);
+		query.exec("SELECT formId, sentenceId FROM formSentence");
+		while (query.next())
+			links.push_back(make_pair(query.value(0).toUInt(),
+				query.value(1).toUInt()));
+	}
 
-	while (query.next())
-		sentenceIds.insert(query.value(0).toUInt());
-	
-	return sentenceIds;
+	return FormSentenceIncidence(links, unparsable);
+}
+
+void printCurve(Forms const &forms, Curve const &curve)
+{
+	for (size_t i = 0; i < curve.points.size(); ++i)
+	{
+		EvaluationPoint const &point = curve.points[i];
+		cout << i + 1 << "\t" << point.recall << "\t" << point.precision <<
+			"\t" << point.fscore << "\t" << point.betaFscore << "\t" <<
+			forms[curve.ranking[i]].form.toLatin1().data() << "\n";
+	}
+}
+
+// Print the curves of multiple scoring methods side by side.
+void printCurves(QList<ScoringMethod> const &methods,
+	QList<Curve> const &curves)
+{
+	cout << "rank";
+	for (int i = 0; i < methods.size(); ++i)
+	{
+		string name = scoringMethodName(methods[i]);
+		cout << "\t" << name << ".recall\t" << name << ".precision\t" <<
+			name << ".fscore\t" << name << ".betafscore";
+	}
+	cout << "\n";
+
+	size_t nPoints = curves.isEmpty() ? 0 : curves.first().points.size();
+	for (size_t i = 0; i < nPoints; ++i)
+	{
+		cout << i + 1;
+		for (int j = 0; j < curves.size(); ++j)
+		{
+			EvaluationPoint const &point = curves[j].points[i];
+			cout << "\t" << point.recall << "\t" << point.precision <<
+				"\t" << point.fscore << "\t" << point.betaFscore;
+		}
+		cout << "\n";
+	}
 }
 
 void usage(string const &programName)
 {
 	cout << "Usage: " << programName << " database scoring_method" << endl << endl <<
-    "where scoring_method is one of:" << endl << endl <<
-    "scoring_susp\t\t\tsuspicion" << endl <<
-    "scoring_susp_obs\t\tsuspicion * number of observations" << endl <<
-    "scoring_susp_uniqsents\t\tsuspicion * unique sentences" << endl <<
-    "scoring_susp_ln_obs\t\tsuspicion * ln(number of observations)" << endl <<
-    "scoring_susp_ln_uniqsents\tsuspicion * ln(unique sentences)" << endl;
+    "where scoring_method is one of:" << endl << endl;
+
+	for (size_t i = 0; i < N_SCORING_METHODS; ++i)
+	{
+		string name(SCORING_METHODS[i].name);
+		cout << name << string(name.size() < 24 ? 32 - name.size() : 8, ' ') <<
+			SCORING_METHODS[i].description << endl;
+	}
+
+	cout << endl << "Multiple scoring methods can be evaluated at once, by" <<
+		" giving a comma-separated" << endl << "list of scoring methods, or" <<
+		" 'all'. The curves are then printed side by side." << endl;
 }
 
 int main(int argc, char *argv[])
 {
 	double const beta = 0.5;
-	double const betaSquare = beta * beta;
 
 	QCoreApplication app(argc, argv);
 
@@ -171,38 +349,27 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
-	FormScoreSet formScores(scoreForms(selectScoringMethod(argv[2])));
+	QList<ScoringMethod> methods(selectScoringMethods(argv[2]));
 
-	QSet<size_t> allParsableFound;
-	QSet<size_t> allUnparsableFound;
+	Forms forms(readForms());
+	FormSentenceIncidence incidence(loadIncidence());
 
-	QSet<size_t> allParsable(allSentences(false));
-	QSet<size_t> allUnparsable(allSentences(true));
+	// Queries are executed on this thread, the database connection cannot
+	// be shared with the evaluation threads.
+	Rankings rankings;
+	if (hasScoreColumns())
+		rankings = readRankings(forms, methods);
 
-	size_t i = 0;
-	FormScoreSet::const_iterator iter = formScores.begin();
-	while (iter != formScores.end())
-	{
-		QSet<size_t> unparsableFound = formSentences(iter->form, true);
-		allUnparsableFound.unite(unparsableFound);
-		QSet<size_t> parsableFound = formSentences(iter->form, false);
-		allParsableFound.unite(parsableFound);
-
-		double recall = allUnparsableFound.size() /
-			static_cast<double>(allUnparsable.size());
-		double precision = allUnparsableFound.size() /
-			static_cast<double>(allUnparsableFound.size() + allParsableFound.size());
-		double fscore = (2.0 * precision * recall) / (precision + recall);
-		double betaFscore = ((1.0 + betaSquare) *  precision * recall) /
-			(betaSquare * precision + recall);
-
-		cout << i + 1 << "\t" << recall << "\t" << precision <<
-			"\t" << fscore << "\t" << betaFscore << "\t" <<
-			iter->form.toLatin1().data() << endl;
-
-		++i;
-		++iter;
-	}
+	// The results of mapped() are delivered in the order of the methods.
+	QFuture<Curve> curvesFuture = QtConcurrent::mapped(methods,
+		EvaluateMethod(&forms, &incidence, &rankings, beta));
+	curvesFuture.waitForFinished();
+	QList<Curve> curves = curvesFuture.results();
+
+	if (methods.size() == 1)
+		printCurve(forms, curves.first());
+	else
+		printCurves(methods, curves);
 
 	return 0;
 }
@@ -0,0 +1,664 @@
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sqlite3.h>
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QIODevice>
+#include <QMetaType>
+#include <QObject>
+#include <QRegExp>
+#include <QSharedPointer>
+#include <QSqlDatabase>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVariant>
+#include <QVector>
+
+#include <QtDebug>
+
+#include <errormining/ScoringMethod.hh>
+#include <errormining/TrigramIndex.hh>
+
+#include "DatabaseWorker.hh"
+#include "FormFilter.hh"
+
+using namespace std;
+using namespace errormining;
+using namespace miningviewer;
+
+namespace {
+
+QString const CONNECTION_NAME = "worker";
+
+// Number of sentences that are sent at once.
+int const SENTENCE_BATCH_SIZE = 1000;
+
+// Number of candidate sentences that are verified with one query.
+int const CANDIDATE_BATCH_SIZE = 1000;
+
+// Progress is reported after this number of forms.
+int const FORMS_PROGRESS_INTERVAL = 100000;
+
+// Number of SQLite virtual machine instructions between checks for
+// superseded queries.
+int const PROGRESS_HANDLER_INTERVAL = 10000;
+
+}
+
+extern "C" {
+    static void deleteRegExp(void *regexp) {
+        delete static_cast<QRegExp *>(regexp);
+    }
+
+    static void regexpFun(sqlite3_context *ctx, int argc, sqlite3_value **argv) {
+        if (argc < 2)
+            return;
+
+        uchar const *lhs = sqlite3_value_text(argv[1]);
+        if (lhs == 0)
+            return;
+        QString text(QString::fromUtf8(reinterpret_cast<char const *>(lhs)));
+
+        // The expression is compiled once per statement, SQLite keeps
+        // it with the (constant) argument.
+        QRegExp *regexp = static_cast<QRegExp *>(sqlite3_get_auxdata(ctx, 0));
+        if (regexp == 0) {
+            uchar const *rhs = sqlite3_value_text(argv[0]);
+            if (rhs == 0)
+                return;
+            QString expr(QString::fromUtf8(reinterpret_cast<char const *>(rhs)));
+
+            regexp = new QRegExp(expr);
+            sqlite3_set_auxdata(ctx, 0, regexp, deleteRegExp);
+
+            // SQLite may have deleted the expression immediately.
+            regexp = static_cast<QRegExp *>(sqlite3_get_auxdata(ctx, 0));
+            if (regexp == 0) {
+                QRegExp tmpRegExp(expr);
+                sqlite3_result_int(ctx, text.contains(tmpRegExp) ? 1 : 0);
+                return;
+            }
+        }
+
+        if (text.contains(*regexp))
+            sqlite3_result_int(ctx, 1);
+        else
+            sqlite3_result_int(ctx, 0);
+    }
+
+    // Interrupt the query that is executed when it is superseded.
+    static int progressHandler(void *data) {
+        return static_cast<DatabaseWorker const *>(data)->superseded() ? 1 : 0;
+    }
+}
+
+DatabaseWorker::DatabaseWorker(QObject *parent) : QObject(parent),
+	d_hasTrigramIndex(false), d_hasScoreColumns(false), d_activeCounter(0), d_activeGeneration(0)
+{
+	qRegisterMetaType<FormFilter>("miningviewer::FormFilter");
+	qRegisterMetaType<QVector<FormEntry> >("QVector<miningviewer::FormEntry>");
+	qRegisterMetaType<QVector<uint> >("QVector<uint>");
+}
+
+void DatabaseWorker::beginQuery(QAtomicInt const *generationCounter,
+	int generation)
+{
+	d_activeCounter = generationCounter;
+	d_activeGeneration = generation;
+}
+
+bool DatabaseWorker::candidateSentences(QString const &regExp,
+	TrigramIndex::Postings *candidates)
+{
+	if (!d_hasTrigramIndex)
+		return false;
+
+	vector<string> literals = TrigramIndex::regExpLiterals(
+		regExp.toUtf8().constData());
+	if (literals.empty())
+		return false;
+
+	vector<quint32> trigrams;
+	for (vector<string>::const_iterator iter = literals.begin();
+			iter != literals.end(); ++iter)
+	{
+		vector<quint32> literalTrigrams = TrigramIndex::trigrams(iter->data(),
+			iter->size());
+		trigrams.insert(trigrams.end(), literalTrigrams.begin(),
+			literalTrigrams.end());
+	}
+	sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+	QStringList trigramStrs;
+	for (vector<quint32>::const_iterator iter = trigrams.begin();
+			iter != trigrams.end(); ++iter)
+		trigramStrs.append(QString::number(*iter));
+
+	QSqlDatabase db = QSqlDatabase::database(CONNECTION_NAME);
+
+	// Posting lists are intersected from short to long, so that the
+	// candidates shrink as early as possible.
+	QSqlQuery sizeQuery(db);
+	sizeQuery.exec("SELECT length(sentenceIds), trigram FROM sentenceTrigrams"
+		" WHERE trigram IN (" + trigramStrs.join(",") + ")");
+	vector<pair<qlonglong, quint32> > sizes;
+	while (sizeQuery.next())
+		sizes.push_back(make_pair(sizeQuery.value(0).toLongLong(),
+			sizeQuery.value(1).toUInt()));
+	sort(sizes.begin(), sizes.end());
+
+	candidates->clear();
+
+	// A trigram that does not occur in any sentence.
+	if (sizes.size() != trigrams.size())
+		return true;
+
+	QSqlQuery postingsQuery(db);
+	postingsQuery.prepare("SELECT sentenceIds FROM sentenceTrigrams"
+		" WHERE trigram = :trigram");
+	for (vector<pair<qlonglong, quint32> >::const_iterator iter = sizes.begin();
+			iter != sizes.end(); ++iter)
+	{
+		if (superseded())
+			break;
+
+		postingsQuery.bindValue(":trigram", iter->second);
+		if (!postingsQuery.exec() || !postingsQuery.next())
+			return false;
+
+		QByteArray data = postingsQuery.value(0).toByteArray();
+		TrigramIndex::Postings postings;
+		TrigramIndex::decode(data.constData(), data.size(), &postings);
+
+		if (iter == sizes.begin())
+			candidates->swap(postings);
+		else
+			*candidates = TrigramIndex::intersect(*candidates, postings);
+
+		if (candidates->empty())
+			break;
+	}
+
+	return true;
+}
+
+void DatabaseWorker::close()
+{
+	QSqlDatabase::database(CONNECTION_NAME, false).close();
+	QSqlDatabase::removeDatabase(CONNECTION_NAME);
+}
+
+void DatabaseWorker::countForms()
+{
+	QSqlQuery formsQuery(QSqlDatabase::database(CONNECTION_NAME));
+	formsQuery.exec("SELECT COUNT(*) FROM forms");
+	formsQuery.next();
+	emit formsCounted(formsQuery.value(0).toInt());
+}
+
+void DatabaseWorker::endQuery()
+{
+	d_activeCounter = 0;
+}
+
+bool DatabaseWorker::execStatements(char const * const *statements)
+{
+	QSqlQuery query(QSqlDatabase::database(CONNECTION_NAME));
+	for (; *statements != 0; ++statements)
+		if (!query.exec(*statements))
+			return false;
+
+	return true;
+}
+
+void DatabaseWorker::fetchForms(int generation, int firstRow,
+	QVector<uint> const &formIds)
+{
+	// The view has moved on to another list of forms.
+	if (generation != d_formsGeneration)
+		return;
+
+	// Identifiers are integers, so they can be put in the query directly.
+	QStringList formIdStrs;
+	for (QVector<uint>::const_iterator iter = formIds.begin();
+			iter != formIds.end(); ++iter)
+		formIdStrs.append(QString::number(*iter));
+
+	QSqlQuery formQuery(QSqlDatabase::database(CONNECTION_NAME));
+	formQuery.exec("SELECT rowid, form FROM forms WHERE rowid IN (" +
+		formIdStrs.join(",") + ")");
+
+	QHash<uint, QString> forms;
+	while (formQuery.next())
+		forms.insert(formQuery.value(0).toUInt(), formQuery.value(1).toString());
+
+	// Forms are sent in the order of the request.
+	QStringList orderedForms;
+	for (QVector<uint>::const_iterator iter = formIds.begin();
+			iter != formIds.end(); ++iter)
+		orderedForms.append(forms.value(*iter));
+
+	emit formsFetched(generation, firstRow, formIds, orderedForms);
+}
+
+void DatabaseWorker::loadFormInfo(uint formId)
+{
+	QSqlQuery formInfoQuery(QSqlDatabase::database(CONNECTION_NAME));
+	formInfoQuery.prepare("SELECT suspicion, freq, suspFreq, uniqSentsFreq"
+		" FROM forms WHERE rowid = :rowid");
+	formInfoQuery.bindValue(":rowid", formId);
+	formInfoQuery.exec();
+	if (!formInfoQuery.next())
+		return;
+
+	QStringList info;
+	for (int i = 0; i < 4; ++i)
+		info.append(formInfoQuery.value(i).toString());
+
+	emit formInfoLoaded(formId, info);
+}
+
+void DatabaseWorker::loadForms(int generation, FormFilter const &filter,
+	int scoringMethod, int sortColumn, int sortOrder)
+{
+	if (generation != d_formsGeneration)
+		return;
+
+	QSharedPointer<ScoreFun> scoreFun = selectScoreFun(
+		static_cast<ScoringMethod>(scoringMethod));
+
+	// When sorting on the form column, the database orders the forms.
+	// Precomputed scores are ordered by the database as well, using the
+	// index on the score column.
+	QString scores = scoreColumn(scoringMethod);
+	QString orderBy;
+	if (sortColumn == 1)
+		orderBy = sortOrder == Qt::AscendingOrder ? "form" : "form DESC";
+	else if (!scores.isEmpty())
+		orderBy = sortOrder == Qt::AscendingOrder ?
+			scores + ", suspFreq, form DESC" :
+			scores + " DESC, suspFreq DESC, form";
+
+	beginQuery(&d_formsGeneration, generation);
+
+	QSqlQuery formsQuery(QSqlDatabase::database(CONNECTION_NAME));
+	prepareFormsQuery(&formsQuery, filter, scores.isEmpty() ?
+		"rowid, suspicion, freq, suspFreq, uniqSentsFreq" : "rowid, " + scores,
+		orderBy);
+	formsQuery.exec();
+
+	QVector<FormEntry> entries;
+	while (formsQuery.next())
+	{
+		if (superseded())
+			break;
+
+		double score;
+		if (scores.isEmpty())
+			score = (*scoreFun)(formsQuery.value(1).toDouble(),
+				formsQuery.value(2).toUInt(), formsQuery.value(3).toUInt(),
+				formsQuery.value(4).toUInt());
+		else
+			score = formsQuery.value(1).toDouble();
+		entries.append(FormEntry(formsQuery.value(0).toUInt(), score));
+
+		if (entries.size() % FORMS_PROGRESS_INTERVAL == 0)
+			emit formsLoading(generation, entries.size());
+	}
+
+	endQuery();
+
+	// An interrupted query ends like a query without results.
+	if (generation != d_formsGeneration)
+		return;
+
+	if (sortColumn == 0 && scores.isEmpty())
+	{
+		if (sortOrder == Qt::AscendingOrder)
+			std::sort(entries.begin(), entries.end(), ScoreLess());
+		else
+			std::sort(entries.begin(), entries.end(), ScoreGreater());
+	}
+
+	emit formsLoaded(generation, entries);
+}
+
+void DatabaseWorker::loadSentences(int generation, bool allSentences,
+	uint formId, QString const &regExp)
+{
+	if (generation != d_sentencesGeneration)
+		return;
+
+	beginQuery(&d_sentencesGeneration, generation);
+
+	// When searching all sentences, the trigram index gives the
+	// sentences that could match, only those are verified with the
+	// regular expression.
+	TrigramIndex::Postings candidates;
+	bool useCandidates = allSentences && !regExp.isEmpty() &&
+		candidateSentences(regExp, &candidates);
+
+	QSqlQuery sentenceQuery(QSqlDatabase::database(CONNECTION_NAME));
+	// With candidates, a query is prepared per batch of candidates.
+	if (allSentences && !useCandidates)
+		sentenceQuery.prepare("SELECT sentences.sentence FROM sentences"
+			" WHERE sentences.unparsable = 'true' AND sentences.sentence REGEXP :regexp");
+	else if (!allSentences && regExp.isEmpty())
+		sentenceQuery.prepare("SELECT sentences.sentence FROM sentences, formSentence"
+			" WHERE formSentence.formId = :rowid AND"
+			" sentences.rowid = formSentence.sentenceId AND"
+			" sentences.unparsable = 'true'");
+	else if (!allSentences)
+		sentenceQuery.prepare("SELECT sentences.sentence FROM sentences, formSentence"
+			" WHERE formSentence.formId = :rowid AND"
+			" sentences.rowid = formSentence.sentenceId AND"
+			" sentences.unparsable = 'true' AND sentences.sentence REGEXP :regexp");
+
+	// Send the sentences in batches, so that the first sentences are
+	// shown while the remaining sentences are retrieved.
+	QStringList sentences;
+	size_t nextCandidate = 0;
+	bool done = useCandidates && candidates.empty();
+	while (!done && !superseded())
+	{
+		done = true;
+		if (useCandidates)
+		{
+			// Candidates are verified in batches, in order of their
+			// identifiers. Identifiers are integers, so they can be put
+			// in the query directly.
+			size_t end = min(candidates.size(),
+				nextCandidate + CANDIDATE_BATCH_SIZE);
+			QStringList candidateStrs;
+			for (; nextCandidate != end; ++nextCandidate)
+				candidateStrs.append(QString::number(candidates[nextCandidate]));
+
+			QString queryStr("SELECT sentences.sentence FROM sentences"
+				" WHERE sentences.rowid IN (" + candidateStrs.join(",") + ") AND"
+				" sentences.unparsable = 'true' AND sentences.sentence REGEXP :regexp");
+			sentenceQuery.prepare(queryStr);
+			done = nextCandidate == candidates.size();
+		}
+
+		if (!allSentences)
+			sentenceQuery.bindValue(":rowid", formId);
+		if (!regExp.isEmpty())
+			sentenceQuery.bindValue(":regexp", regExp);
+
+		sentenceQuery.exec();
+
+		while (sentenceQuery.next())
+		{
+			if (superseded())
+				break;
+
+			sentences.append(sentenceQuery.value(0).toString());
+			if (sentences.size() == SENTENCE_BATCH_SIZE)
+			{
+				emit sentencesLoaded(generation, sentences);
+				sentences.clear();
+			}
+		}
+	}
+
+	endQuery();
+
+	if (generation == d_sentencesGeneration && !sentences.isEmpty())
+		emit sentencesLoaded(generation, sentences);
+}
+
+int DatabaseWorker::newFormsGeneration()
+{
+	return d_formsGeneration.fetchAndAddOrdered(1) + 1;
+}
+
+int DatabaseWorker::newSentencesGeneration()
+{
+	return d_sentencesGeneration.fetchAndAddOrdered(1) + 1;
+}
+
+bool DatabaseWorker::open(QString const &filename)
+{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", CONNECTION_NAME);
+	db.setDatabaseName(filename);
+    if (!db.open())
+        return false;
+
+    // Get the sqlite3 database handle
+    QVariant handleV = db.driver()->handle();
+    if (handleV.isValid() && qstrcmp(handleV.typeName(), "sqlite3*") == 0) {
+         sqlite3 *handle = *static_cast<sqlite3 **>(handleV.data());
+         if (handle != 0) {
+             if (sqlite3_create_function(handle, "regexp", -1, SQLITE_ANY, 0, regexpFun, 0, 0) != SQLITE_OK)
+                 qWarning() << "Could not register REGEXP operator with sqlite!";
+             sqlite3_progress_handler(handle, PROGRESS_HANDLER_INTERVAL,
+                 progressHandler, this);
+         }
+     }
+
+    QSqlQuery tableQuery(db);
+    tableQuery.exec("SELECT name FROM sqlite_master WHERE type = 'table'");
+    while (tableQuery.next()) {
+        QString table = tableQuery.value(0).toString();
+        if (table == "sentenceTrigrams")
+            d_hasTrigramIndex = true;
+        else if (table == "statistics")
+            d_hasScoreColumns = true;
+    }
+
+    return true;
+}
+
+void DatabaseWorker::prepareFormsQuery(QSqlQuery *query,
+	FormFilter const &filter, QString const &columns,
+	QString const &orderBy) const
+{
+	// The average suspicion is maintained in the statistics table, older
+	// databases compute it from all forms.
+	QString avgSuspicion = d_hasScoreColumns ?
+		"(SELECT suspicionSum / nForms FROM statistics)" :
+		"(SELECT AVG(suspicion) FROM forms)";
+
+	QString queryStr("SELECT " + columns + " FROM forms WHERE");
+	if (filter.avgMultiplierMethod)
+		queryStr += " suspicion >= :avgMultiplier * " + avgSuspicion +
+			" AND suspFreq >= :unparsableFreqThreshold AND freq >= :unparsableFreqThreshold";
+	else
+		queryStr += " suspicion >= :suspThreshold"
+			" AND suspFreq >= :unparsableFreqThreshold AND freq >= :parsableFreqThreshold";
+
+	// The regular expression is applied by the REGEXP function, so that
+	// forms that do not match are never retrieved.
+	if (!filter.regExp.isEmpty())
+		queryStr += " AND form REGEXP :regExp";
+
+	if (!orderBy.isEmpty())
+		queryStr += " ORDER BY " + orderBy;
+
+	query->prepare(queryStr);
+	if (filter.avgMultiplierMethod)
+		query->bindValue(":avgMultiplier", filter.avgMultiplier);
+	else
+	{
+		query->bindValue(":suspThreshold", filter.suspThreshold);
+		query->bindValue(":parsableFreqThreshold", filter.parsableFreqThreshold);
+	}
+	query->bindValue(":unparsableFreqThreshold", filter.unparsableFreqThreshold);
+	if (!filter.regExp.isEmpty())
+		query->bindValue(":regExp", filter.regExp);
+}
+
+void DatabaseWorker::removeForms(QVector<uint> const &formIds, bool deep)
+{
+	QSqlDatabase db = QSqlDatabase::database(CONNECTION_NAME);
+
+	// The whole selection is removed with a fixed number of set-based
+	// statements. The identifiers of the selected forms, the sentences
+	// that are removed, and the forms that occur in those sentences are
+	// collected in temporary tables.
+	static char const * const CREATE_TEMP_TABLES[] = {
+		"CREATE TEMP TABLE IF NOT EXISTS selectedForms"
+			" (formId INTEGER PRIMARY KEY)",
+		"CREATE TEMP TABLE IF NOT EXISTS removedSentences"
+			" (sentenceId INTEGER PRIMARY KEY)",
+		"CREATE TEMP TABLE IF NOT EXISTS affectedForms"
+			" (formId INTEGER PRIMARY KEY)",
+		"DELETE FROM temp.selectedForms",
+		"DELETE FROM temp.removedSentences",
+		"DELETE FROM temp.affectedForms",
+		0
+	};
+
+	// The link table has covering indexes on (formId, sentenceId) and
+	// (sentenceId, formId), so that these statements only touch the
+	// links of the removed sentences.
+	static char const * const DEEP_REMOVAL[] = {
+		"INSERT OR IGNORE INTO temp.removedSentences"
+			" SELECT sentenceId FROM formSentence"
+			" WHERE formId IN (SELECT formId FROM temp.selectedForms)",
+		"INSERT OR IGNORE INTO temp.affectedForms"
+			" SELECT formId FROM formSentence"
+			" WHERE sentenceId IN (SELECT sentenceId FROM temp.removedSentences)",
+		// Selected forms are removed, even if they do not occur in any
+		// sentence.
+		"INSERT OR IGNORE INTO temp.affectedForms"
+			" SELECT formId FROM temp.selectedForms",
+		"DELETE FROM sentences"
+			" WHERE rowid IN (SELECT sentenceId FROM temp.removedSentences)",
+		"DELETE FROM formSentence"
+			" WHERE sentenceId IN (SELECT sentenceId FROM temp.removedSentences)",
+		// Only forms that do not occur in any sentence anymore are
+		// removed.
+		"DELETE FROM temp.affectedForms WHERE EXISTS (SELECT 1 FROM formSentence"
+			" WHERE formSentence.formId = temp.affectedForms.formId)",
+		0
+	};
+
+	static char const * const SHALLOW_REMOVAL[] = {
+		"INSERT INTO temp.affectedForms SELECT formId FROM temp.selectedForms",
+		0
+	};
+
+	// The statistics are updated before the forms are removed.
+	static char const * const UPDATE_STATISTICS[] = {
+		"UPDATE statistics SET"
+			" nForms = nForms - (SELECT COUNT(*) FROM forms"
+			" WHERE rowid IN (SELECT formId FROM temp.affectedForms)),"
+			" suspicionSum = suspicionSum - (SELECT TOTAL(suspicion) FROM forms"
+			" WHERE rowid IN (SELECT formId FROM temp.affectedForms))",
+		0
+	};
+
+	static char const * const REMOVE_FORMS[] = {
+		"DELETE FROM forms"
+			" WHERE rowid IN (SELECT formId FROM temp.affectedForms)",
+		0
+	};
+
+	db.transaction();
+
+	bool success = execStatements(CREATE_TEMP_TABLES);
+
+	QSqlQuery selectQuery(db);
+	selectQuery.prepare("INSERT OR IGNORE INTO temp.selectedForms VALUES (:formId)");
+	for (QVector<uint>::const_iterator iter = formIds.begin();
+			success && iter != formIds.end(); ++iter)
+	{
+		selectQuery.bindValue(":formId", *iter);
+		success = selectQuery.exec();
+	}
+
+	if (success)
+		success = execStatements(deep ? DEEP_REMOVAL : SHALLOW_REMOVAL);
+	if (success && d_hasScoreColumns)
+		success = execStatements(UPDATE_STATISTICS);
+	if (success)
+		success = execStatements(REMOVE_FORMS);
+
+	QVector<uint> removedFormIds;
+	if (success)
+	{
+		QSqlQuery removedQuery(db);
+		success = removedQuery.exec("SELECT formId FROM temp.affectedForms");
+		while (removedQuery.next())
+			removedFormIds.append(removedQuery.value(0).toUInt());
+	}
+
+	if (!success || !db.commit())
+	{
+		db.rollback();
+		emit error("Could not remove form(s)",
+			"Could not remove the selected form(s)! Do you have write access "
+			"to this database?");
+		return;
+	}
+
+	emit formsRemoved(removedFormIds);
+}
+
+void DatabaseWorker::saveForms(QString const &filename,
+	FormFilter const &filter, int scoringMethod)
+{
+	QFile formsFile(filename);
+	if (!formsFile.open(QIODevice::WriteOnly))
+	{
+		emit error("Could not save forms", "Could not open file for writing!");
+		return;
+	}
+
+	QTextStream formsOut(&formsFile);
+
+	QSharedPointer<ScoreFun> scoreFun = selectScoreFun(
+		static_cast<ScoringMethod>(scoringMethod));
+
+	QString scores = scoreColumn(scoringMethod);
+
+	QSqlQuery formsQuery(QSqlDatabase::database(CONNECTION_NAME));
+	prepareFormsQuery(&formsQuery, filter,
+		"form, suspicion, freq, suspFreq, uniqSentsFreq" +
+		(scores.isEmpty() ? QString() : ", " + scores), QString());
+	formsQuery.exec();
+
+	while (formsQuery.next())
+	{
+		QString form = formsQuery.value(0).toString();
+		double suspicion = formsQuery.value(1).toDouble();
+		uint freq = formsQuery.value(2).toUInt();
+		uint suspFreq = formsQuery.value(3).toUInt();
+		uint uniqSentsFreq = formsQuery.value(4).toUInt();
+
+		// Score this form, unless the score was precomputed.
+		double score = scores.isEmpty() ?
+			(*scoreFun)(suspicion, freq, suspFreq, uniqSentsFreq) :
+			formsQuery.value(5).toDouble();
+
+		formsOut << form << " " << score << " " << freq << " " << suspFreq << "\n";
+	}
+
+	formsOut.flush();
+}
+
+QString DatabaseWorker::scoreColumn(int scoringMethod) const
+{
+	if (!d_hasScoreColumns)
+		return QString();
+
+	return QString::fromLatin1(scoringMethodColumn(
+		static_cast<ScoringMethod>(scoringMethod)).c_str());
+}
+
+bool DatabaseWorker::superseded() const
+{
+	return d_activeCounter != 0 && *d_activeCounter != d_activeGeneration;
+}
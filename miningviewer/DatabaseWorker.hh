@@ -0,0 +1,164 @@
+#ifndef _DATABASEWORKER_HH
+#define _DATABASEWORKER_HH
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <errormining/TrigramIndex.hh>
+
+#include "FormFilter.hh"
+
+class QSqlQuery;
+
+namespace miningviewer {
+
+/**
+ * Performs all queries on the mining database. The worker should be
+ * moved to its own thread, and its slots invoked through queued
+ * connections, so that the user interface does not block on the
+ * database. The worker uses its own database connection, which is
+ * opened with open().
+ *
+ * Queries for forms and sentences carry a generation. Starting a new
+ * generation supersedes queries of earlier generations: queued queries
+ * are skipped, and a running query is interrupted.
+ */
+class DatabaseWorker : public QObject
+{
+	Q_OBJECT
+public:
+	DatabaseWorker(QObject *parent = 0);
+
+	/**
+	 * Start a new generation of form queries, and return it. This
+	 * method can be called from any thread.
+	 */
+	int newFormsGeneration();
+
+	/**
+	 * Start a new generation of sentence queries, and return it. This
+	 * method can be called from any thread.
+	 */
+	int newSentencesGeneration();
+
+	/**
+	 * Return true if the query that is currently executed was
+	 * superseded.
+	 */
+	bool superseded() const;
+
+public slots:
+	/**
+	 * Close the database connection.
+	 */
+	void close();
+
+	/**
+	 * Count the forms in the database, the count is sent with
+	 * formsCounted().
+	 */
+	void countForms();
+
+	/**
+	 * Retrieve the texts of forms, they are sent with formsFetched().
+	 */
+	void fetchForms(int generation, int firstRow, QVector<uint> const &formIds);
+
+	/**
+	 * Retrieve the suspicion, frequency, unparsable frequency and unique
+	 * sentence frequency of a form, they are sent with formInfoLoaded().
+	 */
+	void loadFormInfo(uint formId);
+
+	/**
+	 * Retrieve and score the forms that satisfy a filter, sorted on the
+	 * given column. The forms are sent with formsLoaded().
+	 */
+	void loadForms(int generation, miningviewer::FormFilter const &filter,
+		int scoringMethod, int sortColumn, int sortOrder);
+
+	/**
+	 * Retrieve unparsable sentences of a form, or all unparsable
+	 * sentences if allSentences is true, that match a regular
+	 * expression. The sentences are sent in parts with sentencesLoaded().
+	 */
+	void loadSentences(int generation, bool allSentences, uint formId,
+		QString const &regExp);
+
+	/**
+	 * Open the database.
+	 */
+	bool open(QString const &filename);
+
+	/**
+	 * Remove forms. Deep removal also removes the sentences in which
+	 * the forms occur, and forms that only occurred in those sentences.
+	 * The identifiers of all removed forms are sent with formsRemoved().
+	 */
+	void removeForms(QVector<uint> const &formIds, bool deep);
+
+	/**
+	 * Write the scored forms that satisfy a filter to a file.
+	 */
+	void saveForms(QString const &filename,
+		miningviewer::FormFilter const &filter, int scoringMethod);
+
+signals:
+	void error(QString const &title, QString const &message);
+	void formInfoLoaded(uint formId, QStringList const &info);
+	void formsCounted(int nForms);
+	void formsFetched(int generation, int firstRow,
+		QVector<uint> const &formIds, QStringList const &forms);
+	void formsLoaded(int generation,
+		QVector<miningviewer::FormEntry> const &entries);
+	void formsLoading(int generation, int nForms);
+	void formsRemoved(QVector<uint> const &formIds);
+	void sentencesLoaded(int generation, QStringList const &sentences);
+
+private:
+	DatabaseWorker(DatabaseWorker const &other);
+	DatabaseWorker &operator=(DatabaseWorker const &other);
+
+	// Find the unparsable sentences that could match a regular
+	// expression with the trigram index. Returns false if the index
+	// cannot be used for the expression.
+	bool candidateSentences(QString const &regExp,
+		errormining::TrigramIndex::Postings *candidates);
+
+	// Return the column with precomputed scores for a scoring method,
+	// or an empty string if the database has no score columns.
+	QString scoreColumn(int scoringMethod) const;
+
+	// Prepare a query for the given columns of the forms that satisfy
+	// a filter.
+	void prepareFormsQuery(QSqlQuery *query, FormFilter const &filter,
+		QString const &columns, QString const &orderBy) const;
+
+	// Execute a null-terminated list of statements, stops at the first
+	// statement that fails.
+	bool execStatements(char const * const *statements);
+
+	// Mark the start and end of an interruptable query.
+	void beginQuery(QAtomicInt const *generationCounter, int generation);
+	void endQuery();
+
+	// Databases created by older versions have no trigram index, and
+	// no score columns and statistics.
+	bool d_hasTrigramIndex;
+	bool d_hasScoreColumns;
+
+	QAtomicInt d_formsGeneration;
+	QAtomicInt d_sentencesGeneration;
+
+	// Generation counter and generation of the query that is executed,
+	// only used by the worker thread.
+	QAtomicInt const *d_activeCounter;
+	int d_activeGeneration;
+};
+
+}
+
+#endif // _DATABASEWORKER_HH
@@ -0,0 +1,79 @@
+#ifndef _FORMFILTER_HH
+#define _FORMFILTER_HH
+
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+
+namespace miningviewer {
+
+/**
+ * The criteria that forms should satisfy to be listed.
+ */
+struct FormFilter
+{
+	FormFilter() : avgMultiplierMethod(false), suspThreshold(0.0),
+		avgMultiplier(0.0), unparsableFreqThreshold(0),
+		parsableFreqThreshold(0) {}
+
+	bool avgMultiplierMethod;
+	double suspThreshold;
+	double avgMultiplier;
+	uint unparsableFreqThreshold;
+	uint parsableFreqThreshold;
+
+	/**
+	 * Only list forms that match this regular expression, if it is not
+	 * empty.
+	 */
+	QString regExp;
+};
+
+/**
+ * The database identifier and score of a listed form.
+ */
+struct FormEntry
+{
+	FormEntry() : formId(0), score(0.0) {}
+	FormEntry(uint newFormId, double newScore) :
+		formId(newFormId), score(newScore) {}
+
+	uint formId;
+	double score;
+};
+
+/**
+ * Order form entries by ascending score. Forms with the same score are
+ * ordered by their identifiers.
+ */
+struct ScoreLess
+{
+	bool operator()(FormEntry const &a, FormEntry const &b) const
+	{
+		if (a.score != b.score)
+			return a.score < b.score;
+		return a.formId < b.formId;
+	}
+};
+
+/**
+ * Order form entries by descending score. Forms with the same score are
+ * ordered by their identifiers.
+ */
+struct ScoreGreater
+{
+	bool operator()(FormEntry const &a, FormEntry const &b) const
+	{
+		if (a.score != b.score)
+			return a.score > b.score;
+		return a.formId < b.formId;
+	}
+};
+
+}
+
+Q_DECLARE_METATYPE(miningviewer::FormFilter)
+Q_DECLARE_METATYPE(QVector<miningviewer::FormEntry>)
+Q_DECLARE_METATYPE(QVector<uint>)
+
+#endif // _FORMFILTER_HH
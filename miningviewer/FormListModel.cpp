@@ -0,0 +1,232 @@
+#include <algorithm>
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QModelIndex>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+#include "FormFilter.hh"
+#include "FormListModel.hh"
+
+using namespace miningviewer;
+
+namespace {
+
+// Number of consecutive rows for which forms are requested at once.
+int const FETCH_BLOCK_SIZE = 256;
+
+// Maximum number of cached forms.
+int const FORM_CACHE_SIZE = 64 * FETCH_BLOCK_SIZE;
+
+}
+
+FormListModel::FormListModel(QObject *parent) : QAbstractItemModel(parent),
+	d_generation(0), d_sortColumn(0), d_sortOrder(Qt::DescendingOrder),
+	d_forms(FORM_CACHE_SIZE)
+{
+}
+
+void FormListModel::addForms(int generation, int firstRow,
+	QVector<uint> const &formIds, QStringList const &forms)
+{
+	// Forms that were requested for a previous list are discarded.
+	if (generation != d_generation)
+		return;
+
+	d_requestedBlocks.remove(firstRow / FETCH_BLOCK_SIZE);
+
+	for (int i = 0; i < formIds.size(); ++i)
+		d_forms.insert(formIds[i], new QString(forms[i]));
+
+	if (!formIds.isEmpty())
+		emit dataChanged(index(firstRow, 1),
+			index(firstRow + formIds.size() - 1, 1));
+}
+
+int FormListModel::columnCount(QModelIndex const &parent) const
+{
+	if (parent.isValid())
+		return 0;
+
+	return 2;
+}
+
+QVariant FormListModel::data(QModelIndex const &index, int role) const
+{
+	if (!index.isValid())
+		return QVariant();
+
+	FormEntry const &entry = d_entries[index.row()];
+
+	if (role == Qt::UserRole)
+		return entry.formId;
+
+	if (role != Qt::DisplayRole)
+		return QVariant();
+
+	if (index.column() == 0)
+		return QString::number(entry.score);
+
+	QString *form = d_forms.object(entry.formId);
+	if (form == 0)
+	{
+		// The form is shown when it arrives.
+		requestForms(index.row());
+		return QVariant();
+	}
+
+	return *form;
+}
+
+Qt::ItemFlags FormListModel::flags(QModelIndex const &index) const
+{
+	if (!index.isValid())
+		return Qt::NoItemFlags;
+
+	return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+QVariant FormListModel::headerData(int section, Qt::Orientation orientation,
+	int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	if (section == 0)
+		return QString("Score");
+	else
+		return QString("Form");
+}
+
+QModelIndex FormListModel::index(int row, int column,
+	QModelIndex const &parent) const
+{
+	if (parent.isValid() || row < 0 || row >= d_entries.size() ||
+			column < 0 || column >= 2)
+		return QModelIndex();
+
+	return createIndex(row, column);
+}
+
+QModelIndex FormListModel::parent(QModelIndex const &) const
+{
+	return QModelIndex();
+}
+
+void FormListModel::reorder(int column, Qt::SortOrder order)
+{
+	emit layoutAboutToBeChanged();
+
+	QModelIndexList oldIndexes = persistentIndexList();
+	QVector<uint> formIds;
+	formIds.reserve(oldIndexes.size());
+	for (QModelIndexList::const_iterator iter = oldIndexes.begin();
+			iter != oldIndexes.end(); ++iter)
+		formIds.append(d_entries[iter->row()].formId);
+
+	// When only the order changes, reversing the entries also reverses
+	// the ordering of forms with the same score by the database.
+	if (column == d_sortColumn)
+		std::reverse(d_entries.begin(), d_entries.end());
+	else if (order == Qt::AscendingOrder)
+		std::sort(d_entries.begin(), d_entries.end(), ScoreLess());
+	else
+		std::sort(d_entries.begin(), d_entries.end(), ScoreGreater());
+
+	d_sortColumn = column;
+	d_sortOrder = order;
+
+	// Form texts are cached by identifier, but requests are made per
+	// block of rows.
+	d_requestedBlocks.clear();
+
+	if (!oldIndexes.isEmpty())
+	{
+		QHash<uint, int> rows;
+		for (int i = 0; i < d_entries.size(); ++i)
+			rows.insert(d_entries[i].formId, i);
+
+		QModelIndexList newIndexes;
+		for (int i = 0; i < oldIndexes.size(); ++i)
+			newIndexes.append(index(rows.value(formIds[i]),
+				oldIndexes[i].column()));
+		changePersistentIndexList(oldIndexes, newIndexes);
+	}
+
+	emit layoutChanged();
+}
+
+void FormListModel::requestForms(int row) const
+{
+	int block = row / FETCH_BLOCK_SIZE;
+	if (d_requestedBlocks.contains(block))
+		return;
+
+	d_requestedBlocks.insert(block);
+
+	int begin = block * FETCH_BLOCK_SIZE;
+	int end = qMin(begin + FETCH_BLOCK_SIZE, d_entries.size());
+
+	QVector<uint> formIds;
+	formIds.reserve(end - begin);
+	for (int i = begin; i < end; ++i)
+		formIds.append(d_entries[i].formId);
+
+	// Requesting forms does not change the contents of the model.
+	emit const_cast<FormListModel *>(this)->formsRequested(d_generation,
+		begin, formIds);
+}
+
+int FormListModel::row(uint formId) const
+{
+	for (int i = 0; i < d_entries.size(); ++i)
+		if (d_entries[i].formId == formId)
+			return i;
+
+	return -1;
+}
+
+int FormListModel::rowCount(QModelIndex const &parent) const
+{
+	if (parent.isValid())
+		return 0;
+
+	return d_entries.size();
+}
+
+void FormListModel::setForms(int generation, QVector<FormEntry> const &entries,
+	int sortColumn, Qt::SortOrder sortOrder)
+{
+	d_generation = generation;
+	d_entries = entries;
+	d_sortColumn = sortColumn;
+	d_sortOrder = sortOrder;
+
+	// Forms could have been removed from the database.
+	d_forms.clear();
+	d_requestedBlocks.clear();
+
+	reset();
+}
+
+void FormListModel::sort(int column, Qt::SortOrder order)
+{
+	if (column == d_sortColumn && order == d_sortOrder)
+		return;
+
+	// Only the database can order the forms by their texts, since the
+	// texts are not kept in memory.
+	if (column == 0 || column == d_sortColumn)
+	{
+		reorder(column, order);
+		return;
+	}
+
+	d_sortColumn = column;
+	d_sortOrder = order;
+
+	emit sortChanged();
+}
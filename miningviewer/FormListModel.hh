@@ -0,0 +1,139 @@
+#ifndef _FORMLISTMODEL_HH
+#define _FORMLISTMODEL_HH
+
+#include <QAbstractItemModel>
+#include <QCache>
+#include <QModelIndex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+#include "FormFilter.hh"
+
+namespace miningviewer {
+
+/**
+ * A model of the forms in the mining database, with a score and a form
+ * column. Only the identifiers and scores of the forms are kept in
+ * memory, in the current sort order. The text of a form is requested
+ * when a view asks for it, together with the forms in the surrounding
+ * rows, and is cached when it arrives.
+ *
+ * The model does not query the database itself: the forms are set by
+ * the owner of the model, and form texts are requested through the
+ * formsRequested() signal.
+ */
+class FormListModel : public QAbstractItemModel
+{
+	Q_OBJECT
+public:
+	FormListModel(QObject *parent = 0);
+
+	/**
+	 * Replace the listed forms. The entries are sorted on the given
+	 * column, in the given order, which become the sort order of the
+	 * model. The generation identifies the query that retrieved the
+	 * forms, and is passed along with requests for form texts.
+	 */
+	void setForms(int generation, QVector<FormEntry> const &entries,
+		int sortColumn, Qt::SortOrder sortOrder);
+
+	/**
+	 * Return the database identifier of the form in the given row.
+	 */
+	uint formId(int row) const;
+
+	/**
+	 * Return the row of the form with the given database identifier, or
+	 * -1 if the form is not listed.
+	 */
+	int row(uint formId) const;
+
+	/**
+	 * Return the column on which the forms should be sorted.
+	 */
+	int sortColumn() const;
+
+	/**
+	 * Return the order in which the forms should be sorted.
+	 */
+	Qt::SortOrder sortOrder() const;
+
+	int columnCount(QModelIndex const &parent = QModelIndex()) const;
+	QVariant data(QModelIndex const &index, int role = Qt::DisplayRole) const;
+	Qt::ItemFlags flags(QModelIndex const &index) const;
+	QVariant headerData(int section, Qt::Orientation orientation,
+		int role = Qt::DisplayRole) const;
+	QModelIndex index(int row, int column,
+		QModelIndex const &parent = QModelIndex()) const;
+	QModelIndex parent(QModelIndex const &index) const;
+	int rowCount(QModelIndex const &parent = QModelIndex()) const;
+
+	/**
+	 * Sort the forms. The listed forms are reordered in memory when they
+	 * are sorted on the score column, or when only the order changes.
+	 * Otherwise, sortChanged() is emitted.
+	 */
+	void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+
+public slots:
+	/**
+	 * Add form texts that were requested with formsRequested().
+	 */
+	void addForms(int generation, int firstRow,
+		QVector<uint> const &formIds, QStringList const &forms);
+
+signals:
+	/**
+	 * Request the texts of the forms starting at the given row.
+	 */
+	void formsRequested(int generation, int firstRow,
+		QVector<uint> const &formIds);
+
+	/**
+	 * Emitted when the forms are sorted on the form column. The forms
+	 * should be set again, in the new order.
+	 */
+	void sortChanged();
+
+private:
+	FormListModel(FormListModel const &other);
+	FormListModel &operator=(FormListModel const &other);
+
+	// Reorder the listed forms in memory, keeping persistent indexes
+	// (such as the current form of a view) on the same forms.
+	void reorder(int column, Qt::SortOrder order);
+
+	// Request the forms of the block of rows that contains a row, if
+	// they were not requested yet.
+	void requestForms(int row) const;
+
+	QVector<FormEntry> d_entries;
+	int d_generation;
+	int d_sortColumn;
+	Qt::SortOrder d_sortOrder;
+	mutable QCache<uint, QString> d_forms;
+	mutable QSet<int> d_requestedBlocks;
+};
+
+inline uint FormListModel::formId(int row) const
+{
+	return d_entries[row].formId;
+}
+
+inline int FormListModel::sortColumn() const
+{
+	return d_sortColumn;
+}
+
+inline Qt::SortOrder FormListModel::sortOrder() const
+{
+	return d_sortOrder;
+}
+
+}
+
+#endif // _FORMLISTMODEL_HH
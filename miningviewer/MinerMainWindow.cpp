@@ -1,48 +1,89 @@
 #include <cmath>
-#include <set>
 
 #include <QClipboard>
 #include <QDialog>
-#include <QErrorMessage>
-#include <QFile>
 #include <QFileDialog>
-#include <QIODevice>
+#include <QItemSelectionModel>
 #include <QMainWindow>
 #include <QMessageBox>
+#include <QModelIndex>
 #include <QRegExp>
+#include <QSet>
 #include <QSettings>
 #include <QSharedPointer>
-#include <QSqlError>
-#include <QSqlQuery>
-#include <QSqlQueryModel>
+#include <QStringList>
 #include <QTextDocument>
-#include <QTextStream>
-#include <QTreeWidgetItem>
+#include <QTimer>
+#include <QVector>
 #include <QWidget>
 
 #include <errormining/ScoringMethod.hh>
 
 #include "global.hh"
-#include "FormTreeWidgetItem.hh"
+#include "DatabaseWorker.hh"
+#include "FormFilter.hh"
+#include "FormListModel.hh"
 #include "MinerMainWindow.hh"
 #include "PreferencesDialog.hh"
+#include "SentenceListModel.hh"
 
 using namespace std;
 using namespace errormining;
 using namespace miningviewer;
 
-MinerMainWindow::MinerMainWindow(QWidget *parent) : QMainWindow(parent)
+MinerMainWindow::MinerMainWindow(DatabaseWorker *worker, QWidget *parent) :
+	QMainWindow(parent), d_worker(worker), d_formsGeneration(0),
+	d_sentencesGeneration(0), d_formsSortColumn(0),
+	d_formsSortOrder(Qt::DescendingOrder), d_currentFormId(0), d_selectFormId(0),
+	d_removalRow(0)
 {
 	d_minerMainWindow.setupUi(this);
 
 	readSettings();
+
+	// Requests to the database worker.
+	connect(this, SIGNAL(countFormsRequested()), d_worker, SLOT(countForms()));
+	connect(this, SIGNAL(formInfoRequested(uint)),
+		d_worker, SLOT(loadFormInfo(uint)));
+	connect(this,
+		SIGNAL(formsRequested(int, miningviewer::FormFilter, int, int, int)),
+		d_worker, SLOT(loadForms(int, miningviewer::FormFilter, int, int, int)));
+	connect(this, SIGNAL(removeFormsRequested(QVector<uint>, bool)),
+		d_worker, SLOT(removeForms(QVector<uint>, bool)));
+	connect(this,
+		SIGNAL(saveFormsRequested(QString, miningviewer::FormFilter, int)),
+		d_worker, SLOT(saveForms(QString, miningviewer::FormFilter, int)));
+	connect(this, SIGNAL(sentencesRequested(int, bool, uint, QString)),
+		d_worker, SLOT(loadSentences(int, bool, uint, QString)));
+	connect(&d_formModel, SIGNAL(formsRequested(int, int, QVector<uint>)),
+		d_worker, SLOT(fetchForms(int, int, QVector<uint>)));
+
+	// Results of the database worker.
+	connect(d_worker, SIGNAL(error(QString, QString)),
+		this, SLOT(databaseError(QString, QString)));
+	connect(d_worker, SIGNAL(formInfoLoaded(uint, QStringList)),
+		this, SLOT(formInfoLoaded(uint, QStringList)));
+	connect(d_worker, SIGNAL(formsCounted(int)), this, SLOT(formsCounted(int)));
+	connect(d_worker, SIGNAL(formsFetched(int, int, QVector<uint>, QStringList)),
+		&d_formModel, SLOT(addForms(int, int, QVector<uint>, QStringList)));
+	connect(d_worker,
+		SIGNAL(formsLoaded(int, QVector<miningviewer::FormEntry>)),
+		this, SLOT(formsLoaded(int, QVector<miningviewer::FormEntry>)));
+	connect(d_worker, SIGNAL(formsLoading(int, int)),
+		this, SLOT(formsLoading(int, int)));
+	connect(d_worker, SIGNAL(formsRemoved(QVector<uint>)),
+		this, SLOT(formsRemoved(QVector<uint>)));
+	connect(d_worker, SIGNAL(sentencesLoaded(int, QStringList)),
+		this, SLOT(sentencesLoaded(int, QStringList)));
+
 	updateStatistics();
 
-	d_minerMainWindow.formsTreeWidget->sortByColumn(0, Qt::DescendingOrder);
+	d_minerMainWindow.formsView->setModel(&d_formModel);
+	d_minerMainWindow.formsView->sortByColumn(0, Qt::DescendingOrder);
 
 	showForms();
 
-	d_minerMainWindow.formsTreeWidget->setSortingEnabled(true);
+	d_minerMainWindow.formsView->setSortingEnabled(true);
 
     connect(d_minerMainWindow.copyAction, SIGNAL(triggered()),
 		this, SLOT(copySentence()));
@@ -50,16 +91,22 @@ MinerMainWindow::MinerMainWindow(QWidget *parent) : QMainWindow(parent)
 		this, SLOT(showPreferences()));
 	connect(d_minerMainWindow.scoringComboBox, SIGNAL(currentIndexChanged(int)),
 		this, SLOT(scoringMethodChanged(int)));
-	connect(d_minerMainWindow.formsTreeWidget,
-		SIGNAL(currentItemChanged(QTreeWidgetItem *, QTreeWidgetItem *)),
-		this, SLOT(formSelected(QTreeWidgetItem *, QTreeWidgetItem *)));
+	connect(d_minerMainWindow.formsView->selectionModel(),
+		SIGNAL(currentChanged(const QModelIndex &, const QModelIndex &)),
+		this, SLOT(formSelected(const QModelIndex &, const QModelIndex &)));
+	connect(&d_formModel, SIGNAL(sortChanged()), this, SLOT(formsSortChanged()));
     connect(d_minerMainWindow.removeFormPushButton, SIGNAL(clicked()),
 		this, SLOT(removeSelectedForms()));
     connect(d_minerMainWindow.saveAction, SIGNAL(triggered()),
 		this, SLOT(saveForms()));
-	
 
-	// Regular expression LineEdits.
+	// Regular expression LineEdits. Form queries that are superseded are
+	// cancelled, so the forms can be filtered while the user types.
+	d_filterTimer.setSingleShot(true);
+	d_filterTimer.setInterval(300);
+	connect(d_minerMainWindow.regExpLineEdit, SIGNAL(textEdited(const QString &)),
+		&d_filterTimer, SLOT(start()));
+	connect(&d_filterTimer, SIGNAL(timeout()), this, SLOT(regExpChanged()));
 	connect(d_minerMainWindow.regExpLineEdit, SIGNAL(returnPressed()),
 		this, SLOT(regExpChanged()));
     connect(d_minerMainWindow.sentenceRegExpLineEdit, SIGNAL(returnPressed()),
@@ -84,57 +131,148 @@ void MinerMainWindow::copySentence()
     }
 }
 
-bool MinerMainWindow::isValidForm(QString const &form) const
+void MinerMainWindow::databaseError(QString const &title,
+	QString const &message)
+{
+	d_minerMainWindow.statusbar->showMessage(d_statistics);
+
+	QMessageBox errorMessage(QMessageBox::Critical, title, message,
+		QMessageBox::Ok, this);
+	errorMessage.exec();
+}
+
+FormFilter MinerMainWindow::formFilter() const
+{
+	// Retrieve threshold preferences.
+	QSettings settings("RUG", "Mining Viewer");
+
+	FormFilter filter;
+	filter.avgMultiplierMethod = settings.value(THRESHOLD_METHOD_SETTING,
+		SUSP_THRESHOLD_METHOD_DEFAULT).toString() == AVG_MULTIPLIER_METHOD;
+	filter.suspThreshold = settings.value(SUSP_THRESHOLD_SETTING,
+		SUSP_THRESHOLD_SETTING_DEFAULT).toDouble();
+	filter.avgMultiplier = settings.value(AVG_MULTIPLIER_SETTING,
+		AVG_MULTIPLIER_SETTING_DEFAULT).toDouble();
+	filter.unparsableFreqThreshold =
+		settings.value(UNPARSABLE_FREQ_THRESHOLD_SETTING,
+			UNPARSABLE_FREQ_THRESHOLD_DEFAULT).toUInt();
+	filter.parsableFreqThreshold =
+		settings.value(FREQ_THRESHOLD_SETTING, FREQ_THRESHOLD_DEFAULT).toUInt();
+
+	if (d_filterRegExp.data() != 0)
+		filter.regExp = d_filterRegExp->pattern();
+
+	return filter;
+}
+
+void MinerMainWindow::formInfoLoaded(uint formId, QStringList const &info)
 {
-	QSqlQuery formQuery;
-	formQuery.prepare("SELECT COUNT(*) FROM forms WHERE form = :form");
-	formQuery.bindValue(":form", form);
-	formQuery.exec();
-	formQuery.next();
+	// Another form could have been selected in the meantime.
+	if (formId != d_currentFormId)
+		return;
 
-	if (formQuery.value(0).toInt() < 1)
-		return false;
+	d_minerMainWindow.suspicionLabel->setText(info[0]);
+	d_minerMainWindow.freqLabel->setText(info[1]);
+	d_minerMainWindow.suspFreqLabel->setText(info[2]);
+	d_minerMainWindow.uniqSentsFreqLabel->setText(info[3]);
+}
 
-	return true;
+void MinerMainWindow::formsCounted(int nForms)
+{
+	d_statistics = "Database contains " + QString::number(nForms) + " forms";
+	d_minerMainWindow.statusbar->showMessage(d_statistics);
 }
 
-void MinerMainWindow::formSelected(QTreeWidgetItem *item, QTreeWidgetItem *)
+void MinerMainWindow::formSelected(QModelIndex const &current, QModelIndex const &)
 {
     if (d_minerMainWindow.allSentenceMatchCheckBox->isChecked())
 		d_minerMainWindow.sentenceRegExpLineEdit->clear();
 
-	if (item == 0) {
-		d_minerMainWindow.suspicionLabel->clear();
-		d_minerMainWindow.freqLabel->clear();
-		d_minerMainWindow.suspFreqLabel->clear();
-		d_minerMainWindow.uniqSentsFreqLabel->clear();
-		
-		updateSentenceList();
+	d_minerMainWindow.suspicionLabel->clear();
+	d_minerMainWindow.freqLabel->clear();
+	d_minerMainWindow.suspFreqLabel->clear();
+	d_minerMainWindow.uniqSentsFreqLabel->clear();
 
+	if (!current.isValid()) {
+		d_currentFormId = 0;
+		updateSentenceList();
         return;
 	}
 
-    uint rowid = item->data(0, Qt::UserRole).toUInt();
-
-	{
-		QSqlQuery formInfoQuery;
-
-		formInfoQuery.prepare("SELECT suspicion, freq, suspFreq, uniqSentsFreq"
-            " FROM forms WHERE rowid = :rowid");
-        formInfoQuery.bindValue(":rowid", rowid);
-		formInfoQuery.exec();
-		formInfoQuery.next();
-		
-		d_minerMainWindow.suspicionLabel->setText(formInfoQuery.value(0).toString());
-		d_minerMainWindow.freqLabel->setText(formInfoQuery.value(1).toString());
-		d_minerMainWindow.suspFreqLabel->setText(formInfoQuery.value(2).toString());
-		d_minerMainWindow.uniqSentsFreqLabel->setText(
-			formInfoQuery.value(3).toString());
-	}
+	// The labels are filled when the information arrives.
+	d_currentFormId = d_formModel.formId(current.row());
+	emit formInfoRequested(d_currentFormId);
 
     updateSentenceList();
 }
 
+void MinerMainWindow::formsLoaded(int generation,
+	QVector<FormEntry> const &entries)
+{
+	if (generation != d_formsGeneration)
+		return;
+
+	// Apply sorting that was done while the forms were loading.
+	int sortColumn = d_formModel.sortColumn();
+	Qt::SortOrder sortOrder = d_formModel.sortOrder();
+	d_formModel.setForms(generation, entries, d_formsSortColumn,
+		d_formsSortOrder);
+	d_formModel.sort(sortColumn, sortOrder);
+	d_minerMainWindow.statusbar->showMessage(d_statistics);
+
+	// Resetting the model clears the current form. Select the form that
+	// was current before sorting or removal, if it is still listed.
+	int row = d_selectFormId == 0 ? -1 : d_formModel.row(d_selectFormId);
+	d_selectFormId = 0;
+
+	if (row == -1)
+		formSelected(QModelIndex(), QModelIndex());
+	else
+		d_minerMainWindow.formsView->setCurrentIndex(d_formModel.index(row, 0));
+}
+
+void MinerMainWindow::formsLoading(int generation, int nForms)
+{
+	if (generation != d_formsGeneration)
+		return;
+
+	d_minerMainWindow.statusbar->showMessage("Loading forms... " +
+		QString::number(nForms));
+}
+
+void MinerMainWindow::formsRemoved(QVector<uint> const &formIds)
+{
+	QSet<uint> removed;
+	for (QVector<uint>::const_iterator iter = formIds.begin();
+			iter != formIds.end(); ++iter)
+		removed.insert(*iter);
+
+	// Scan up from the first selected form until we find a form that was
+	// not removed, the model still has the forms from before the removal.
+	int row = qMin(d_removalRow, d_formModel.rowCount() - 1);
+	while (row > 0 && removed.contains(d_formModel.formId(row)))
+		--row;
+
+	if (row >= 0 && !removed.contains(d_formModel.formId(row)))
+		d_selectFormId = d_formModel.formId(row);
+
+	updateStatistics();
+
+	// Redisplay forms, the form that was found is selected when the forms
+	// are loaded.
+	showForms();
+}
+
+void MinerMainWindow::formsSortChanged()
+{
+	// Keep the current form selected after sorting.
+	QModelIndex current = d_minerMainWindow.formsView->currentIndex();
+	if (current.isValid())
+		d_selectFormId = d_formModel.formId(current.row());
+
+	showForms();
+}
+
 void MinerMainWindow::readSettings()
 {
 	QSettings settings("RUG", "Mining Viewer");
@@ -152,6 +290,9 @@ void MinerMainWindow::readSettings()
 
 void MinerMainWindow::regExpChanged()
 {
+	// The filter is applied now, rather than after a pause in typing.
+	d_filterTimer.stop();
+
 	QString regexStr = d_minerMainWindow.regExpLineEdit->text();
 
 	// If the regexp line edit widget has a zero-length, we suppose
@@ -187,161 +328,40 @@ void MinerMainWindow::removeSelectedForms()
 {
 	// This method removes all selected forms. After removing forms, we'll
 	// want to select an item close to the removed items, to avoid scrolling
-	// back to the beginning after a removal. This is harder than it seems,
-	// because the underlying queries can also remove forms preceeding or
-	// succeeding the selected forms (namely orphaned forms). For this
-	// reason, we can't use absolute row numbers. Additionally, pointers
-	// can't be used either, since the list items are newly allocated when
-	// the list of forms is refreshed. Setting the correct position is
-	// a kludge, but is now done in the following manner:
+	// back to the beginning after a removal. Since the underlying queries
+	// can also remove forms preceeding or succeeding the selected forms
+	// (namely orphaned forms), we can't use absolute row numbers. The
+	// position is restored in the following manner:
 	//
-	// 1. We take the first item of the selected items, and get it
-	//    index, named 'newIndex'.
-	// 2. After removing the forms from the database, we still have
-	//    the old form list around. We go up this list until we find
-	//    a form that is still in the database. We store the literal
-	//    name of the form.
-	// 3. After the list of forms is refreshed, we search for the
-	//    literal found in the previous step, and make the first item
-	//    that was found (only one should be found) the currently
-	//    selected item.
-
-	QList<QTreeWidgetItem *> selectedItems =
-		d_minerMainWindow.formsTreeWidget->selectedItems();
-	
-	QTreeWidgetItem *treeRootItem =
-		d_minerMainWindow.formsTreeWidget->invisibleRootItem();
+	// 1. We take the first row of the selection, named 'd_removalRow'.
+	// 2. The database worker removes the forms, and reports all forms
+	//    that were removed. The model still has the old list of forms.
+	//    We go up this list until we find a form that was not removed,
+	//    and store its identifier (see formsRemoved()).
+	// 3. After the list of forms is refreshed, we look up the row of
+	//    this identifier, and make it the current row (see formsLoaded()).
+
+	QModelIndexList selectedRows =
+		d_minerMainWindow.formsView->selectionModel()->selectedRows();
 
 	// Do nothing when no forms are selected.
-	if (selectedItems.size() == 0)
+	if (selectedRows.size() == 0)
 		return;
 
-	// Get the absolute index of the first item in the selection.
-	int newIndex = treeRootItem->indexOfChild(selectedItems[0]);
+	d_removalRow = selectedRows[0].row();
 
     // Perform deep or shallow removal?
     QSettings settings("RUG", "Mining Viewer");
     bool deepRemoval = settings.value(DEEP_FORM_REMOVAL,
         DEEP_FORM_REMOVAL_DEFAULT).toBool();
 
-	// Remove the forms represented by the selected items.
-	for (QList<QTreeWidgetItem *>::iterator iter = selectedItems.begin();
-			iter != selectedItems.end(); ++iter)
-    {
-        bool success;
-        QString form = (*iter)->text(1);
-        success = deepRemoval ? removeForm(form) : removeFormShallow(form);
-
-        if (!success)
-            return;
-    }
-
-    updateStatistics();
-
-	// Scan up until we find a form that is still valid (exists in the
-	// database).
-	while (newIndex > 0 &&
-		!isValidForm(treeRootItem->child(newIndex)->text(1))) { --newIndex; }
-
-	// Get the valid form as a string.
-	QString selectForm = treeRootItem->child(newIndex)->text(1);
-	
-	// Redisplay forms.
-	showForms();
-
-	// Find a pointer to the item representing the form that we've found to
-	// be valid, and close to a previously selected form.
-	QList<QTreeWidgetItem *> items =
-		d_minerMainWindow.formsTreeWidget->findItems(selectForm, Qt::MatchExactly);
-
-	// If the form was found (should always happen), select it.
-	if (items.size() > 0)
-		d_minerMainWindow.formsTreeWidget->setCurrentItem(items[0]);
-}
-
-bool MinerMainWindow::removeForm(QString const &form)
-{
-	set<int> affectedFormIds;
-	{
-		QSqlQuery affectedFormIdsQuery;
-		affectedFormIdsQuery.prepare("SELECT DISTINCT aux.formId"
-			" FROM formSentence LEFT OUTER JOIN formSentence as aux"
-			" ON formSentence.sentenceId = aux.sentenceId"
-			" WHERE formSentence.formId = "
-			" (SELECT rowid FROM forms WHERE forms.form = :form)") ;
-		affectedFormIdsQuery.bindValue(":form", form);
-		affectedFormIdsQuery.exec();
-
-		while (affectedFormIdsQuery.next())
-			affectedFormIds.insert(affectedFormIdsQuery.value(0).toInt());
-	}
-
-	{
-		QSqlQuery removeSentencesQuery;
-		removeSentencesQuery.prepare("DELETE FROM sentences"
-			" WHERE sentences.rowid IN (SELECT DISTINCT formSentence.sentenceId"
-			" FROM formSentence, forms WHERE formSentence.formId = forms.rowid AND"
-			" forms.form = :form)");
-
-		removeSentencesQuery.bindValue(":form", form);
-		removeSentencesQuery.exec();
-
-		if (removeSentencesQuery.lastError().isValid())
-		{
-			QMessageBox errorMessage(QMessageBox::Critical, "Could not remove form(s)",
-				"Could not remove the selected form(s)! Do you have write access "
-				"to this database?", QMessageBox::Ok, this);
-			errorMessage.exec();
-			return false;
-		}
-	}
-
-	{
-		QSqlQuery removeLinksQuery;
-		removeLinksQuery.prepare("DELETE FROM formSentence"
-			" WHERE formSentence.sentenceId IN"
-			" (SELECT DISTINCT formSentence.sentenceId"
-			" FROM formSentence, forms WHERE formSentence.formId = forms.rowid AND"
-			" forms.form = :form)");
-
-		removeLinksQuery.bindValue(":form", form);
-		removeLinksQuery.exec();
-	}
-
-	removeStaleForms(affectedFormIds);
-	
-	return true;
-}
-
-bool MinerMainWindow::removeFormShallow(const QString &form)
-{
-    QSqlQuery removeFormQuery;
-    removeFormQuery.prepare("DELETE FROM forms"
-        " WHERE forms.form = :form");
-    removeFormQuery.bindValue(":form", form);
-    removeFormQuery.exec();
+	QVector<uint> formIds;
+	for (QModelIndexList::const_iterator iter = selectedRows.begin();
+			iter != selectedRows.end(); ++iter)
+		formIds.append(d_formModel.formId(iter->row()));
 
-    return true;
-}
-
-void MinerMainWindow::removeStaleForms(std::set<int> const &affectedFormIds)
-{
-	QSqlQuery removeFormsQuery;
-	removeFormsQuery.prepare("DELETE FROM forms"
-		" WHERE forms.rowid = :formId AND"
-		" (SELECT COUNT(*) FROM formSentence WHERE formSentence.formId = :formId2) = 0");
-
-	QSqlDatabase::database().transaction();
-
-	for (std::set<int>::const_iterator iter = affectedFormIds.begin();
-		iter != affectedFormIds.end(); ++iter)
-	{
-		removeFormsQuery.bindValue(":formId", *iter);
-		removeFormsQuery.bindValue(":formId2", *iter);
-		removeFormsQuery.exec();
-	}
-
-	QSqlDatabase::database().commit();
+	d_minerMainWindow.statusbar->showMessage("Removing forms...");
+	emit removeFormsRequested(formIds, deepRemoval);
 }
 
 void MinerMainWindow::saveForms()
@@ -350,74 +370,33 @@ void MinerMainWindow::saveForms()
 	if (filename.isNull())
 		return;
 
-	QFile formsFile(filename);
-	if (!formsFile.open(QIODevice::WriteOnly))
-	{
-		QErrorMessage msg(this);
-		msg.showMessage("Could not open file for writing!");
-		return;
-	}
-
-	QTextStream formsOut(&formsFile);
-
-	ScoringMethod curScoringMethod = scoringMethod();
-	QSharedPointer<ScoreFun> scoreFun = selectScoreFun(curScoringMethod);
-
-	// Retrieve threshold preferences.
-	QSettings settings("RUG", "Mining Viewer");
-	double suspThreshold = settings.value(SUSP_THRESHOLD_SETTING,
-		SUSP_THRESHOLD_SETTING_DEFAULT).toDouble();
-	double avgMultiplier = settings.value(AVG_MULTIPLIER_SETTING,
-		AVG_MULTIPLIER_SETTING_DEFAULT).toDouble();
-	QString suspThresholdMethod = settings.value(THRESHOLD_METHOD_SETTING,
-		SUSP_THRESHOLD_METHOD_DEFAULT).toString();
-	uint unparsableFreqThreshold =
-		settings.value(UNPARSABLE_FREQ_THRESHOLD_SETTING,
-			UNPARSABLE_FREQ_THRESHOLD_DEFAULT).toUInt();
-	uint parsableFreqThreshold =
-		settings.value(FREQ_THRESHOLD_SETTING, FREQ_THRESHOLD_DEFAULT).toUInt();
-
-	QSharedPointer<QSqlQuery> query;
-	if (suspThresholdMethod == AVG_MULTIPLIER_METHOD)
-	{
-		query = QSharedPointer<QSqlQuery>(new QSqlQuery("SELECT form, suspicion, suspFreq, uniqSentsFreq"
-			" FROM forms WHERE suspicion >= :avgMultiplier * (SELECT AVG(suspicion) FROM forms) "
-			" AND suspFreq >= :unparsableFreqThreshold AND freq >= :unparsableFreqThreshold"));
-		query->bindValue("avgMultiplier", avgMultiplier);
-	}
-	else
-	{
-		query = QSharedPointer<QSqlQuery>(new QSqlQuery("SELECT form, suspicion, freq, suspFreq, uniqSentsFreq"
-			" FROM forms WHERE suspicion >= :suspThreshold"
-			" AND suspFreq >= :unparsableFreqThreshold AND freq >= :parsableFreqThreshold"));
-		query->bindValue("suspThreshold", suspThreshold);
-	}
+	emit saveFormsRequested(filename, formFilter(), scoringMethod());
+}
 
-	query->bindValue(":unparsableFreqThreshold", unparsableFreqThreshold);
-	query->bindValue(":parsableFreqThreshold", parsableFreqThreshold);
-	query->exec();
+ScoringMethod MinerMainWindow::scoringMethod()
+{
+	int index = d_minerMainWindow.scoringComboBox->currentIndex();
 
-	while (query->next())
+	switch (index)
 	{
-		QString form = query->value(0).toString();
-		double suspicion = query->value(1).toDouble();
-		uint freq = query->value(2).toUInt();
-		uint suspFreq = query->value(3).toUInt();
-		uint uniqSentsFreq = query->value(4).toUInt();
-
-		// If a regular expression was allocated, use it to filter forms;
-		// if this form does not match, skip it.
-		if (d_filterRegExp.data() != 0)
-			if (d_filterRegExp->indexIn(form) == -1)
-				continue;
-
-		// Score this form.
-        double score = (*scoreFun)(suspicion, freq, suspFreq, uniqSentsFreq);
-
-		formsOut << form << " " << score << " " << freq << " " << suspFreq << "\n";
+	case 0:
+		return SCORING_SUSP;
+	case 1:
+		return SCORING_SUSP_OBS;
+	case 2:
+		return SCORING_SUSP_UNIQSENTS;
+	case 3:
+		return SCORING_SUSP_LN_OBS;
+	case 4:
+		return SCORING_SUSP_LN_UNIQSENTS;
+    case 5:
+        return SCORING_SUSP_DELTA;
+    case 6:
+        return SCORING_SUSP_LN_DELTA;
+	default:
+		// Unknown scoring method.
+		return SCORING_SUSP;
 	}
-
-	formsOut.flush();
 }
 
 void MinerMainWindow::scoringMethodChanged(int)
@@ -452,77 +431,24 @@ void MinerMainWindow::sentenceRegExpChanged()
 	updateSentenceList();
 }
 
-void MinerMainWindow::showForms()
+void MinerMainWindow::sentencesLoaded(int generation,
+	QStringList const &sentences)
 {
-	d_minerMainWindow.formsTreeWidget->clear();
-
-	ScoringMethod curScoringMethod = scoringMethod();
-	QSharedPointer<ScoreFun> scoreFun = selectScoreFun(curScoringMethod);
-
-	// Retrieve threshold preferences.
-	QSettings settings("RUG", "Mining Viewer");
-	double suspThreshold = settings.value(SUSP_THRESHOLD_SETTING,
-		SUSP_THRESHOLD_SETTING_DEFAULT).toDouble();
-	double avgMultiplier = settings.value(AVG_MULTIPLIER_SETTING,
-		AVG_MULTIPLIER_SETTING_DEFAULT).toDouble();
-	QString suspThresholdMethod = settings.value(THRESHOLD_METHOD_SETTING,
-		SUSP_THRESHOLD_METHOD_DEFAULT).toString();
-	uint unparsableFreqThreshold =
-		settings.value(UNPARSABLE_FREQ_THRESHOLD_SETTING,
-			UNPARSABLE_FREQ_THRESHOLD_DEFAULT).toUInt();
-	uint parsableFreqThreshold =
-		settings.value(FREQ_THRESHOLD_SETTING, FREQ_THRESHOLD_DEFAULT).toUInt();
-
-	QList<QTreeWidgetItem *> items;
-
-	QSharedPointer<QSqlQuery> query;
-	if (suspThresholdMethod == AVG_MULTIPLIER_METHOD)
-	{
-        query = QSharedPointer<QSqlQuery>(new QSqlQuery("SELECT rowid, form, suspicion, freq, suspFreq, uniqSentsFreq"
-			" FROM forms WHERE suspicion >= :avgMultiplier * (SELECT AVG(suspicion) FROM forms) "
-			" AND suspFreq >= :unparsableFreqThreshold AND freq >= :unparsableFreqThreshold"));
-		query->bindValue("avgMultiplier", avgMultiplier);
-	}
-	else
-	{
-        query = QSharedPointer<QSqlQuery>(new QSqlQuery("SELECT rowid, form, suspicion, freq, suspFreq, uniqSentsFreq"
-			" FROM forms WHERE suspicion >= :suspThreshold"
-			" AND suspFreq >= :unparsableFreqThreshold AND freq >= :parsableFreqThreshold"));
-		query->bindValue("suspThreshold", suspThreshold);
-	}
-
-	query->bindValue(":unparsableFreqThreshold", unparsableFreqThreshold);
-	query->bindValue(":parsableFreqThreshold", parsableFreqThreshold);
-	query->exec();
+	if (generation == d_sentencesGeneration)
+		d_sentenceModel.append(sentences);
+}
 
-	while (query->next())
-	{
-        QVariant id = query->value(0);
-        QString form = query->value(1).toString();
-        double suspicion = query->value(2).toDouble();
-        uint freq = query->value(3).toUInt();
-        uint suspFreq = query->value(4).toUInt();
-        uint uniqSentsFreq = query->value(5).toUInt();
-
-		// If a regular expression was allocated, use it to filter forms;
-		// if this form does not match, skip it.
-		if (d_filterRegExp.data() != 0)
-			if (d_filterRegExp->indexIn(form) == -1)
-				continue;
-
-		// Score this form.
-        double score = (*scoreFun)(suspicion, freq, suspFreq, uniqSentsFreq);
-
-		// Create and add an item for this form.
-		QTreeWidgetItem *item = new FormTreeWidgetItem(0);
-		item->setText(0, QString::number(score));
-		item->setText(1, form);
-        item->setData(0, Qt::UserRole, id);
-		items.append(item);
-	}
-		
-	d_minerMainWindow.formsTreeWidget->insertTopLevelItems(0, items);
-	d_minerMainWindow.formsTreeWidget->setCurrentItem(0);
+void MinerMainWindow::showForms()
+{
+	// Supersede queries for previous lists of forms. The current list is
+	// shown until the new list arrives.
+	d_formsGeneration = d_worker->newFormsGeneration();
+	d_minerMainWindow.statusbar->showMessage("Loading forms...");
+
+	d_formsSortColumn = d_formModel.sortColumn();
+	d_formsSortOrder = d_formModel.sortOrder();
+	emit formsRequested(d_formsGeneration, formFilter(), scoringMethod(),
+		d_formsSortColumn, d_formsSortOrder);
 }
 
 void MinerMainWindow::showPreferences()
@@ -531,78 +457,28 @@ void MinerMainWindow::showPreferences()
 		showForms();
 }
 
-ScoringMethod MinerMainWindow::scoringMethod()
-{
-	int index = d_minerMainWindow.scoringComboBox->currentIndex();
-
-	switch (index)
-	{
-	case 0:
-		return SCORING_SUSP;
-	case 1:
-		return SCORING_SUSP_OBS;
-	case 2:
-		return SCORING_SUSP_UNIQSENTS;
-	case 3:
-		return SCORING_SUSP_LN_OBS;
-	case 4:
-		return SCORING_SUSP_LN_UNIQSENTS;
-    case 5:
-        return SCORING_SUSP_DELTA;
-    case 6:
-        return SCORING_SUSP_LN_DELTA;
-	default:
-		// Unknown scoring method.
-		return SCORING_SUSP;
-	}
-}
-
 void MinerMainWindow::updateSentenceList()
 {
     // Todo: Underline regex, escape HTML
 
     QString expr(d_minerMainWindow.sentenceRegExpLineEdit->text());
 
-    QSqlQuery sentenceQuery;
-
+	// Supersede queries for previously selected forms.
+	d_sentencesGeneration = d_worker->newSentencesGeneration();
+	d_sentenceModel.clear();
     d_minerMainWindow.sentenceView->scrollToTop();
-    if (d_minerMainWindow.allSentenceMatchCheckBox->isChecked() &&
-        !expr.isEmpty() && !expr.isNull()) {
-		sentenceQuery.prepare("SELECT sentences.sentence FROM sentences"
-            " WHERE sentences.unparsable = 'true' AND sentences.sentence REGEXP :regexp");
-        sentenceQuery.bindValue(":regexp", expr);
-	}
-	else {
-		if (d_minerMainWindow.formsTreeWidget->currentItem() == 0)
-			return;
 
-        if (expr.isEmpty() || expr.isNull())
-            sentenceQuery.prepare("SELECT sentences.sentence FROM sentences, formSentence"
-                " WHERE formSentence.formId = :rowid AND"
-                " sentences.rowid = formSentence.sentenceId AND"
-                " sentences.unparsable = 'true'");
-        else {
-            sentenceQuery.prepare("SELECT sentences.sentence FROM sentences, formSentence"
-                                  " WHERE formSentence.formId = :rowid AND"
-                                  " sentences.rowid = formSentence.sentenceId AND"
-                                  " sentences.unparsable = 'true' AND sentences.sentence REGEXP :regexp");
-            sentenceQuery.bindValue(":regexp", expr);
-        }
-        uint rowid = d_minerMainWindow.formsTreeWidget->currentItem()->data(0, Qt::UserRole).toUInt();
-        sentenceQuery.bindValue(":rowid", rowid);
-	}
-
-    sentenceQuery.exec();
-    d_sentenceModel.setQuery(sentenceQuery);
+    if (d_minerMainWindow.allSentenceMatchCheckBox->isChecked() &&
+        !expr.isEmpty() && !expr.isNull())
+		emit sentencesRequested(d_sentencesGeneration, true, 0, expr);
+	else if (d_currentFormId != 0)
+		emit sentencesRequested(d_sentencesGeneration, false, d_currentFormId,
+			expr);
 }
 
 void MinerMainWindow::updateStatistics()
 {
-	QSqlQuery formsQuery;
-	formsQuery.exec("SELECT COUNT(*) FROM forms");
-	formsQuery.next();
-	QString formFreq = formsQuery.value(0).toString();
-	d_minerMainWindow.statusbar->showMessage("Database contains " + formFreq + " forms");
+	emit countFormsRequested();
 }
 
 void MinerMainWindow::writeSettings()
@@ -1,54 +1,79 @@
 #ifndef _MINER_MAINWINDOW_HH
 #define _MINER_MAINWINDOW_HH
 
-#include <set>
-
-#include <QListWidgetItem>
 #include <QMainWindow>
 #include <QModelIndex>
 #include <QRegExp>
 #include <QSharedPointer>
-#include <QSqlQueryModel>
 #include <QString>
-#include <QTreeWidgetItem>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
 #include <QWidget>
 
 #include <errormining/ScoringMethod.hh>
 
+#include "DatabaseWorker.hh"
+#include "FormFilter.hh"
+#include "FormListModel.hh"
 #include "PreferencesDialog.hh"
+#include "SentenceListModel.hh"
 #include "ui_MinerMainWindow.h"
 
 namespace miningviewer {
 
+/**
+ * The main window of the viewer. All database queries are performed by
+ * a database worker, which runs in another thread. The window sends
+ * requests to the worker through signals, and updates the views when
+ * the results arrive.
+ */
 class MinerMainWindow : public QMainWindow
 {
 	Q_OBJECT
 
 public:
-	MinerMainWindow(QWidget *parent = 0);
+	MinerMainWindow(DatabaseWorker *worker, QWidget *parent = 0);
 
 public slots:
 	void close();
 
+signals:
+	void countFormsRequested();
+	void formInfoRequested(uint formId);
+	void formsRequested(int generation, miningviewer::FormFilter const &filter,
+		int scoringMethod, int sortColumn, int sortOrder);
+	void removeFormsRequested(QVector<uint> const &formIds, bool deep);
+	void saveFormsRequested(QString const &filename,
+		miningviewer::FormFilter const &filter, int scoringMethod);
+	void sentencesRequested(int generation, bool allSentences, uint formId,
+		QString const &regExp);
+
 private slots:
 	void copySentence();
+	void databaseError(QString const &title, QString const &message);
+	void formInfoLoaded(uint formId, QStringList const &info);
+	void formsCounted(int nForms);
+	void formsLoaded(int generation,
+		QVector<miningviewer::FormEntry> const &entries);
+	void formsLoading(int generation, int nForms);
+	void formsRemoved(QVector<uint> const &formIds);
+	void formsSortChanged();
 	void scoringMethodChanged(int index);
-	void formSelected(QTreeWidgetItem *item, QTreeWidgetItem *previousItem);
+	void formSelected(QModelIndex const &current, QModelIndex const &previous);
 	void regExpChanged();
 	void removeSelectedForms();
-	void removeStaleForms(std::set<int> const &affectedFormIds);
 	void saveForms();
 	void sentenceRegExpChanged();
+	void sentencesLoaded(int generation, QStringList const &sentences);
 	void showPreferences();
 
 private:
 	MinerMainWindow(MinerMainWindow const &other);
 	MinerMainWindow &operator=(MinerMainWindow const &other);
 
-	bool isValidForm(QString const &form) const;
+	FormFilter formFilter() const;
 	void readSettings();
-	bool removeForm(QString const &form);
-    bool removeFormShallow(const QString &form);
 	void showForms();
 	errormining::ScoringMethod scoringMethod();
     void updateSentenceList();
@@ -57,11 +82,34 @@ private:
 
 	Ui::MinerMainWindow d_minerMainWindow;
 	PreferencesDialog d_preferencesDialog;
+	DatabaseWorker *d_worker;
+	FormListModel d_formModel;
 	QSharedPointer<QRegExp> d_filterRegExp;
-    QSqlQueryModel d_sentenceModel;
+	QTimer d_filterTimer;
+    SentenceListModel d_sentenceModel;
+
+	// Generations of the last form and sentence queries.
+	int d_formsGeneration;
+	int d_sentencesGeneration;
+
+	// The sort order of the last form query. The forms can be sorted in
+	// memory while the query runs.
+	int d_formsSortColumn;
+	Qt::SortOrder d_formsSortOrder;
+
+	// The form that is shown in the form information labels.
+	uint d_currentFormId;
+
+	// The form that should be selected when the forms are loaded, 0
+	// if no form should be selected (SQLite row identifiers start at 1).
+	uint d_selectFormId;
+
+	// The first selected row when forms were removed.
+	int d_removalRow;
+
+	QString d_statistics;
 };
 
 }
 
 #endif // _MINER_MAINWINDOW_HH
-
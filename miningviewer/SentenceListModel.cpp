@@ -0,0 +1,41 @@
+#include <QAbstractListModel>
+#include <QModelIndex>
+#include <QStringList>
+#include <QVariant>
+
+#include "SentenceListModel.hh"
+
+using namespace miningviewer;
+
+void SentenceListModel::append(QStringList const &sentences)
+{
+	if (sentences.isEmpty())
+		return;
+
+	beginInsertRows(QModelIndex(), d_sentences.size(),
+		d_sentences.size() + sentences.size() - 1);
+	d_sentences += sentences;
+	endInsertRows();
+}
+
+void SentenceListModel::clear()
+{
+	d_sentences.clear();
+	reset();
+}
+
+QVariant SentenceListModel::data(QModelIndex const &index, int role) const
+{
+	if (!index.isValid() || role != Qt::DisplayRole)
+		return QVariant();
+
+	return d_sentences[index.row()];
+}
+
+int SentenceListModel::rowCount(QModelIndex const &parent) const
+{
+	if (parent.isValid())
+		return 0;
+
+	return d_sentences.size();
+}
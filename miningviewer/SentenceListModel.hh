@@ -0,0 +1,43 @@
+#ifndef _SENTENCELISTMODEL_HH
+#define _SENTENCELISTMODEL_HH
+
+#include <QAbstractListModel>
+#include <QModelIndex>
+#include <QObject>
+#include <QStringList>
+#include <QVariant>
+
+namespace miningviewer {
+
+/**
+ * A list of sentences, to which sentences can be appended while they
+ * are retrieved.
+ */
+class SentenceListModel : public QAbstractListModel
+{
+	Q_OBJECT
+public:
+	SentenceListModel(QObject *parent = 0) : QAbstractListModel(parent) {}
+
+	/**
+	 * Append sentences to the list.
+	 */
+	void append(QStringList const &sentences);
+
+	/**
+	 * Remove all sentences.
+	 */
+	void clear();
+
+	QVariant data(QModelIndex const &index, int role = Qt::DisplayRole) const;
+	int rowCount(QModelIndex const &parent = QModelIndex()) const;
+private:
+	SentenceListModel(SentenceListModel const &other);
+	SentenceListModel &operator=(SentenceListModel const &other);
+
+	QStringList d_sentences;
+};
+
+}
+
+#endif // _SENTENCELISTMODEL_HH
@@ -5,15 +5,20 @@ CONFIG += qt \
     debug_and_release \
     warn_on
 QT += sql
-HEADERS += FormTreeWidgetItem.hh \
+HEADERS += DatabaseWorker.hh \
+    FormFilter.hh \
+    FormListModel.hh \
     MinerMainWindow.hh \
     PreferencesDialog.hh \
+    SentenceListModel.hh \
     global.hh
 FORMS += MinerMainWindow.ui \
     PreferencesDialog.ui
-SOURCES += FormTreeWidgetItem.cpp \
+SOURCES += DatabaseWorker.cpp \
+    FormListModel.cpp \
     MinerMainWindow.cpp \
     PreferencesDialog.cpp \
+    SentenceListModel.cpp \
     miningviewer.cpp
 
 # Internal headers
@@ -0,0 +1,81 @@
+#!/usr/bin/python
+#
+# Compare the rankings of two mining runs, e.g. a run of a miner that was
+# compiled with single precision suspicions (ERRORMINING_FLOAT_SUSPICION)
+# against a double precision run over the same data.
+#
+# For each k, the overlap is the fraction of the top-k forms of the first
+# ranking that are also in the top-k of the second ranking.
+
+import sys
+
+from optparse import OptionParser
+
+def readRanking(filename):
+    ranking = []
+    suspicions = dict()
+
+    resultsFile = open(filename, 'r')
+
+    for line in resultsFile:
+        lineParts = line.strip().split(' ')
+        if len(lineParts) < 4:
+            continue
+
+        form = ' '.join(lineParts[:-3])
+        ranking.append(form)
+        suspicions[form] = float(lineParts[-3])
+
+    resultsFile.close()
+
+    return (ranking, suspicions)
+
+def topKOverlap(ranking1, ranking2, k):
+    top1 = set(ranking1[:k])
+    top2 = set(ranking2[:k])
+
+    if len(top1) == 0:
+        return 1.0
+
+    return float(len(top1 & top2)) / len(top1)
+
+def maxSuspicionDelta(suspicions1, suspicions2):
+    maxDelta = 0.0
+
+    for (form, suspicion) in suspicions1.items():
+        if form in suspicions2:
+            maxDelta = max(maxDelta, abs(suspicion - suspicions2[form]))
+
+    return maxDelta
+
+def run(options, args):
+    if len(args) != 2:
+        sys.stderr.write("Usage: %s results_ref results_test\n" % sys.argv[0])
+        sys.exit(1)
+
+    (ranking1, suspicions1) = readRanking(args[0])
+    (ranking2, suspicions2) = readRanking(args[1])
+
+    sys.stdout.write("forms\t%d\t%d\n" % (len(ranking1), len(ranking2)))
+
+    for k in map(int, options.k.split(',')):
+        sys.stdout.write("top-%d\t%f\n" % (k,
+            topKOverlap(ranking1, ranking2, k)))
+
+    sys.stdout.write("max-delta\t%g\n" %
+                     maxSuspicionDelta(suspicions1, suspicions2))
+
+    if options.minOverlap != None:
+        for k in map(int, options.k.split(',')):
+            if topKOverlap(ranking1, ranking2, k) < options.minOverlap:
+                sys.exit(2)
+
+if __name__ == "__main__":
+    parser = OptionParser(usage = "%prog [options] results_ref results_test")
+    parser.add_option("-k", dest="k", default="10,100,1000,10000",
+                      help = "Comma-separated list of k values")
+    parser.add_option("-m", type="float", dest="minOverlap", default=None,
+                      help = "Exit with status 2 if an overlap is below this value")
+    (options, args) = parser.parse_args()
+
+    run(options, args)